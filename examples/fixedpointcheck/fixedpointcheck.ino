@@ -0,0 +1,95 @@
+//File: fixedpointcheck.ino
+
+// This sketch checks the fixed-point derived channels against the float reference on the board itself, no WiFi needed.
+// It sweeps synthetic packets over the documented input ranges, prints the largest error of each channel next to the bound from GT7FixedPoint.h
+// and times both paths, so you can see how many cycles the Q16.16 maths saves on an FPU-less ESP8266.
+
+#include <GT7FixedPoint.h>
+
+PacketA packet;
+
+float maxTyreSpeedError = 0;
+float maxSlipRatioError = 0;
+float maxSpeedError = 0;
+float maxBoostError = 0;
+float maxTargetRPMError = 0;
+
+void checkPacket();
+void printResult(const char *name, float error, float bound);
+
+void setup()
+{
+  Serial.begin(115200);
+  memset(&packet, 0, sizeof(packet));
+
+  uint32_t seed = 1;
+  for (int i = 0; i < 5000; ++i)
+  {
+    seed = seed * 1664525UL + 1013904223UL; // Same sequence on every board
+    packet.tyreRadius[0] = 0.1f + 1.9f * ((seed >> 8) & 0xFFFF) / 65535.0f;
+    packet.wheelRPS[0] = ((int32_t)((seed >> 4) & 0xFFFF) - 32768) / 32.768f;
+    packet.wheelRPS[2] = packet.wheelRPS[0];
+    packet.wheelRPS[3] = packet.wheelRPS[0] * 0.98f;
+    packet.speed = 1.0f + 99.0f * ((seed >> 12) & 0xFFFF) / 65535.0f;
+    packet.boost = 3.0f * ((seed >> 16) & 0xFF) / 255.0f;
+    packet.gearRatios[0] = 0.5f + 4.5f * ((seed >> 20) & 0xFF) / 255.0f;
+    checkPacket();
+  }
+
+  printResult("Tyre speed (km/h)", maxTyreSpeedError, 0.0002f);
+  printResult("Slip ratio", maxSlipRatioError, 0.0001f);
+  printResult("Speed (km/h)", maxSpeedError, 0.00005f);
+  printResult("Boost", maxBoostError, 0.00001f);
+  printResult("Target RPM", maxTargetRPMError, 0.005f);
+
+  unsigned long start = micros();
+  volatile float floatSink = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    floatSink = abs(3.6f * packet.tyreRadius[0] * packet.wheelRPS[0]) / (packet.speed * 3.6f);
+  }
+  unsigned long floatTime = micros() - start;
+
+  start = micros();
+  volatile q16_t fixedSink = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    fixedSink = gt7TyreSlipRatioQ16(packet, 0);
+  }
+  unsigned long fixedTime = micros() - start;
+
+  Serial.print("1000 slip ratios, float: ");
+  Serial.print(floatTime);
+  Serial.print("us, Q16: ");
+  Serial.print(fixedTime);
+  Serial.println("us");
+}
+
+void loop()
+{
+}
+
+void checkPacket()
+{
+  // The references are computed in double so the float rounding does not hide the fixed-point error
+  double tyreSpeed = fabs(3.6 * (double)packet.tyreRadius[0] * packet.wheelRPS[0]);
+  double slipRatio = tyreSpeed / (3.6 * packet.speed);
+  double targetRPM = fabs(((double)packet.wheelRPS[2] + packet.wheelRPS[3]) / 2.0) * packet.gearRatios[0] * 60.0 / (2.0 * PI);
+
+  maxTyreSpeedError = max(maxTyreSpeedError, (float)fabs(gt7TyreSpeedQ16(packet, 0) / 65536.0 - tyreSpeed));
+  if (slipRatio < 10.0)
+  {
+    maxSlipRatioError = max(maxSlipRatioError, (float)fabs(gt7TyreSlipRatioQ16(packet, 0) / 65536.0 - slipRatio));
+  }
+  maxSpeedError = max(maxSpeedError, (float)fabs(gt7SpeedKmhQ16(packet) / 65536.0 - 3.6 * packet.speed));
+  maxBoostError = max(maxBoostError, (float)fabs(gt7BoostQ16(packet) / 65536.0 - (packet.boost - 1.0)));
+  maxTargetRPMError = max(maxTargetRPMError, (float)fabs(gt7TargetRPMQ16(packet, 1) / 65536.0 - targetRPM));
+}
+
+void printResult(const char *name, float error, float bound)
+{
+  Serial.print(name);
+  Serial.print(": max error ");
+  Serial.print(error, 6);
+  Serial.println(error <= bound ? " OK" : " EXCEEDS BOUND");
+}
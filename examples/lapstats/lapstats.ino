@@ -0,0 +1,117 @@
+//File: lapstats.ino
+
+// This sketch keeps running statistics for every lap and for the whole stint, without storing any samples.
+// A summary of each completed lap is printed to the serial monitor, together with the fuel left in laps.
+
+//#include "Wifi.h" // ESP32 WiFi include
+#include <ESP8266WiFi.h> // ESP8266 WiFi include
+#include <GT7UDPParser.h>
+#include <GT7LapStats.h>
+
+const char *SSID = "Your WiFi SSID";
+const char *Password = "Your WiFi Password";
+const IPAddress ip(..., ..., ., ..); // Insert your PS4/5 IP address here
+
+void startWiFi();
+void printLap(const LapSummary &lap);
+
+unsigned long previousT = 0;
+const long interval = 500;
+uint32_t previousLapsCompleted = 0;
+
+GT7_UDP_Parser gt7Telem;
+GT7_Lap_Stats lapStats;
+Packet packetContent;
+
+void setup()
+{
+  Serial.begin(115200);
+  startWiFi();
+  gt7Telem.begin(ip);
+  gt7Telem.sendHeartbeat();
+}
+
+void loop()
+{
+  unsigned long currentT = millis();
+  packetContent = gt7Telem.readData();
+  lapStats.update(packetContent.packetContent);
+
+  if (lapStats.getLapsCompleted() != previousLapsCompleted)
+  { // A lap was completed, getNumLaps() would stop changing once MAX_LAPS are kept
+    previousLapsCompleted = lapStats.getLapsCompleted();
+    const LapSummary *lap = lapStats.getLap(0);
+    if (lap != nullptr)
+    {
+      printLap(*lap);
+    }
+
+    float fuelPerLap = lapStats.getAverageFuelPerLap(3);
+    if (fuelPerLap > 0.0f)
+    {
+      Serial.print("Fuel left for laps: ");
+      Serial.println(packetContent.packetContent.fuelLevel / fuelPerLap);
+    }
+  }
+
+  if (currentT - previousT >= interval)
+  { // Send heartbeat every 500ms
+    previousT = currentT;
+    gt7Telem.sendHeartbeat();
+  }
+}
+
+void printLap(const LapSummary &lap)
+{
+  const RunningStat &rpm = lap.getStat(StatChannel::EngineRPM);
+  const RunningStat &speed = lap.getStat(StatChannel::speed);
+
+  Serial.print("Lap ");
+  Serial.print(lap.lapNumber);
+  Serial.print(": ");
+  Serial.print(lap.lapTime / 1000.0f, 3);
+  Serial.print("s, fuel used ");
+  Serial.print(lap.fuelUsed);
+  Serial.print("L, RPM mean ");
+  Serial.print(rpm.mean);
+  Serial.print(" sd ");
+  Serial.print(rpm.standardDeviation());
+  Serial.print(", top speed ");
+  Serial.print(speed.maximum * 3.6f);
+  Serial.println("km/h");
+
+  for (uint8_t gear = 1; gear < GT7_NUM_GEARS; ++gear)
+  {
+    if (lap.gearFrames[gear] > 0)
+    {
+      Serial.print("  Gear ");
+      Serial.print(gear);
+      Serial.print(": ");
+      Serial.print(lap.getGearSeconds(gear));
+      Serial.println("s");
+    }
+  }
+}
+
+void startWiFi()
+{
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(SSID, Password);
+  Serial.print("Attempting to connect to ");
+  Serial.println(SSID);
+
+  uint8_t i = 0;
+  while (WiFi.status() != WL_CONNECTED)
+  {
+    Serial.print('.');
+    delay(250);
+
+    if ((++i % 16) == 0)
+    {
+      Serial.println(F(" still trying to connect"));
+    }
+  }
+
+  Serial.print(F("Connection Successful | IP Address: "));
+  Serial.println(WiFi.localIP());
+}
@@ -9,6 +9,7 @@
 //#include "Wifi.h" // ESP32 WiFi include
 #include <ESP8266WiFi.h> // ESP8266 WiFi include
 #include <GT7UDPParser.h>
+#include <GT7EventEngine.h>
 #include <Servo.h>
 
 const char *SSID = "Your WiFi SSID";
@@ -18,12 +19,14 @@ const IPAddress ip(..., ..., ., ...); // Insert your PS4/5 IP address here
 Servo servo;
 
 void startWiFi();
+void onDayProgression(uint8_t ruleId, float previous, float current);
 
 unsigned long previousT = 0; 
 const long interval = 500; 
-int32_t prevDay;
+bool lightsOut = false; // dayProgression keeps changing every frame after lights out, only react to the first change
 
 GT7_UDP_Parser gt7Telem;
+GT7_Event_Engine events;
 Packet packetContent;
 
 void setup()
@@ -34,17 +37,14 @@ void setup()
   gt7Telem.sendHeartbeat();
   servo.attach(2); // gpio pin 2 (D4)
   servo.write(180);
+  events.addRule(EventField::dayProgression, RuleType::Changed, 0.0f, 0.0f, onDayProgression);
 }
 
 void loop()
 {
   unsigned long currentT = millis() / 10;
   packetContent = gt7Telem.readData();
-
-  if (prevDay != packetContent.packetContent.dayProgression && packetContent.packetContent.dayProgression != 0 && prevDay != 0) {
-    servo.write(0);
-    Serial.println("Lights Out!");
-  }
+  events.update(packetContent.packetContent);
 
   if (currentT - previousT >= interval)
   { // Send heartbeat every 500ms
@@ -52,9 +52,17 @@ void loop()
     gt7Telem.sendHeartbeat();
     //Serial.println("Pckt sent");
   }
+}
 
- prevDay = packetContent.packetContent.dayProgression;
-
+void onDayProgression(uint8_t ruleId, float previous, float current)
+{
+  if (!lightsOut && previous != 0 && current != 0) { // Time of day starts moving at lights out
+    lightsOut = true;
+    servo.write(0);
+    gt7Telem.markConsumed(); // Records how stale the packet was when the servo was triggered
+    Serial.println("Lights Out!");
+    gt7Telem.printLatencyStats(Serial);
+  }
 }
 
 void startWiFi()
@@ -0,0 +1,75 @@
+//File: websocketdashboard.ino
+
+// This sketch streams telemetry to browser dashboards over WebSocket on port 8080 (ws://<board IP>:8080).
+// Each browser gets the field schema and one full packet, then only the fields that changed since the last frame it received.
+// Slow browsers are not queued up: frames they cannot take are skipped and folded into their next delta.
+
+//#include "Wifi.h" // ESP32 WiFi include
+#include <ESP8266WiFi.h> // ESP8266 WiFi include
+#include <GT7UDPParser.h>
+#include <GT7WebSocketServer.h>
+
+const char *SSID = "Your WiFi SSID";
+const char *Password = "Your WiFi Password";
+const IPAddress ip(..., ..., ., ..); // Insert your PS4/5 IP address here
+
+void startWiFi();
+
+unsigned long previousT = 0;
+const long interval = 500;
+int32_t previousPacketId = -1;
+
+GT7_UDP_Parser gt7Telem;
+GT7_WebSocket_Server dashboard(8080);
+Packet packetContent;
+
+void setup()
+{
+  Serial.begin(115200);
+  startWiFi();
+  gt7Telem.begin(ip, 'C');
+  gt7Telem.sendHeartbeat();
+  dashboard.begin();
+}
+
+void loop()
+{
+  unsigned long currentT = millis();
+  packetContent = gt7Telem.readData();
+  dashboard.poll();
+
+  if (packetContent.packetContent.packetId != previousPacketId)
+  {
+    previousPacketId = packetContent.packetContent.packetId;
+    dashboard.broadcast(packetContent.packetContent, gt7Telem.getPacketVersion());
+  }
+
+  if (currentT - previousT >= interval)
+  { // Send heartbeat every 500ms
+    previousT = currentT;
+    gt7Telem.sendHeartbeat();
+  }
+}
+
+void startWiFi()
+{
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(SSID, Password);
+  Serial.print("Attempting to connect to ");
+  Serial.println(SSID);
+
+  uint8_t i = 0;
+  while (WiFi.status() != WL_CONNECTED)
+  {
+    Serial.print('.');
+    delay(250);
+
+    if ((++i % 16) == 0)
+    {
+      Serial.println(F(" still trying to connect"));
+    }
+  }
+
+  Serial.print(F("Connection Successful | IP Address: "));
+  Serial.println(WiFi.localIP());
+}
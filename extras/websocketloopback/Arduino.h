@@ -0,0 +1,19 @@
+// Host stand-in for the parts of Arduino.h used by GT7WebSocketServer, see run.sh
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+inline unsigned long millis() {
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class Print {
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t c) = 0;
+        virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+        size_t print(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+};
@@ -0,0 +1,80 @@
+// Host stand-in for the ESP32 WiFiServer/WiFiClient on POSIX sockets, bound to loopback only
+
+#pragma once
+#include "Arduino.h"
+#include <fcntl.h>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+constexpr int LOOPBACK_SEND_BUFFER = 2048; // Small, so a client that stops reading fills it within seconds
+
+class WiFiClient : public Print {
+    public:
+        WiFiClient() {}
+        explicit WiFiClient(int fd) : socket(new Socket{fd}) {}
+        explicit operator bool() const { return socket && socket->fd >= 0; }
+        int fd() const { return socket ? socket->fd : -1; }
+        int available() {
+            int size = 0;
+            return (socket && ioctl(socket->fd, FIONREAD, &size) == 0) ? size : 0;
+        }
+        int read() {
+            uint8_t c;
+            return (socket && recv(socket->fd, &c, 1, MSG_DONTWAIT) == 1) ? c : -1;
+        }
+        size_t write(uint8_t c) override { return write(&c, 1); }
+        size_t write(const uint8_t* buffer, size_t size) override {
+            ssize_t sent = socket ? send(socket->fd, buffer, size, MSG_NOSIGNAL) : -1;
+            return sent < 0 ? 0 : static_cast<size_t>(sent);
+        }
+        uint8_t connected() {
+            char c;
+            return socket && socket->fd >= 0 && recv(socket->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) != 0;
+        }
+        void stop() { socket.reset(); }
+        void setNoDelay(bool noDelay) {
+            int value = noDelay ? 1 : 0;
+            setsockopt(fd(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+        }
+
+    private:
+        struct Socket {
+            int fd;
+            ~Socket() { close(fd); }
+        };
+        std::shared_ptr<Socket> socket;
+};
+
+class WiFiServer {
+    public:
+        explicit WiFiServer(uint16_t port) : port(port), fd(-1) {}
+        void begin() {
+            fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+            listen(fd, 4);
+            fcntl(fd, F_SETFL, O_NONBLOCK);
+        }
+        WiFiClient available() {
+            int client = accept(fd, nullptr, nullptr);
+            if (client < 0) {
+                return WiFiClient();
+            }
+            int size = LOOPBACK_SEND_BUFFER;
+            setsockopt(client, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+            return WiFiClient(client);
+        }
+
+    private:
+        uint16_t port;
+        int fd;
+};
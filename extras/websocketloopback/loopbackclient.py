@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# WebSocket client for loopbackserver.cpp. Checks the handshake, decodes the schema, applies
+# keyframes and deltas and verifies every reconstructed packet against the generator.
+# --slow stops reading for a while, the server must then skip frames instead of queueing them.
+
+import base64, hashlib, os, socket, struct, sys, time
+
+PACKET_SIZE = 368
+TYPE_FORMATS = {0: 'B', 1: 'c', 2: 'h', 3: 'i', 4: 'f'}
+
+
+def recv_exact(sock, size):
+    data = b''
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise EOFError('server closed the connection')
+        data += chunk
+    return data
+
+
+def read_frame(sock):
+    header = recv_exact(sock, 2)
+    size = header[1] & 0x7F
+    if size == 126:
+        size = struct.unpack('>H', recv_exact(sock, 2))[0]
+    return header[0] & 0x0F, recv_exact(sock, size)
+
+
+def parse_schema(message):
+    assert message[0:5] == b'SGT7S', message[:8]
+    fields = {}
+    position = 7
+    for _ in range(message[6]):
+        offset, field_type, count, name_length = struct.unpack_from('<HBBB', message, position)
+        position += 5
+        name = message[position:position + name_length].decode()
+        position += name_length
+        position += 1 + message[position]
+        fields[len(fields)] = (name, offset, field_type, count)
+    return fields
+
+
+# Keep in sync with loopbackserver.cpp
+LIVE_FLOATS = [
+    'position', 'worldVelocity', 'rotation', 'orientationRelativeToNorth', 'angularVelocity', 'bodyHeight',
+    'EngineRPM', 'fuelLevel', 'speed', 'boost', 'oilPressure', 'tyreTemp', 'roadPlane', 'roadPlaneDistance',
+    'wheelRPS', 'suspHeight', 'UNKNOWNFLOATS', 'RPMFromClutchToGearbox', 'wheelRotation', 'steeringAngularVelocity',
+    'sway', 'heave', 'surge', 'torqueVectors', 'wheelSteeringAngle',
+]
+
+
+def expected(fields, i):
+    # Mirrors fillPacket() in loopbackserver.cpp
+    values = {
+        'magic': [0x47375330], 'fuelCapacity': [100.0], 'gearRatios': [3.5, 0, 0, 0, 0, 0, 0, 0], 'carCode': [1234],
+        'packetId': [i], 'dayProgression': [3600000 + i * 16], 'currentLap': [i * 16 % 90000],
+        'lapCount': [i // 600], 'gears': [1 + i // 120 % 6], 'throttle': [i * 3 % 256], 'brake': [i * 5 % 256],
+        'throttleFiltered': [(i * 3 - 1) % 256], 'brakeFiltered': [(i * 5 - 1) % 256],
+    }
+    j = 0
+    for name, _, field_type, count in fields.values():
+        if field_type == 4 and name in LIVE_FLOATS:
+            values[name] = [((i * (k + 1) + k * 37) % 4093) * 0.125 for k in range(j, j + count)]
+            j += count
+    return values
+
+
+def main():
+    port = int(sys.argv[1]) if len(sys.argv) > 1 and sys.argv[1].isdigit() else 18080
+    slow = '--slow' in sys.argv
+    sock = socket.create_connection(('127.0.0.1', port))
+    if slow:
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 2048)
+
+    key = base64.b64encode(os.urandom(16)).decode()
+    sock.sendall(('GET / HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n'
+                  'Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n' % key).encode())
+    response = b''
+    while b'\r\n\r\n' not in response:
+        response += sock.recv(1)
+    accept = base64.b64encode(hashlib.sha1((key + '258EAFA5-E914-47DA-95CA-C5AB0DC85B11').encode()).digest())
+    assert b'101 Switching Protocols' in response and accept in response, response
+
+    fields = parse_schema(read_frame(sock)[1])
+    by_name = {name: (offset, field_type, count) for name, offset, field_type, count in fields.values()}
+    elements = []
+    for name, offset, field_type, count in fields.values():
+        size = struct.calcsize(TYPE_FORMATS[field_type])
+        elements += [(offset + k * size, size) for k in range(count)]
+    num_elements = len(elements)
+    state = bytearray(PACKET_SIZE)
+    counts = {'K': 0, 'D': 0}
+    total_bytes = 0
+    previous_id = None
+    gaps = 0
+    start = time.time()
+
+    while time.time() - start < 5.0:
+        if slow and counts['D'] == 30:
+            time.sleep(3.0)  # Long enough for the server's send buffer to fill up
+        _, message = read_frame(sock)
+        kind = chr(message[0])
+        counts[kind] += 1
+        total_bytes += len(message)
+        assert message[1:2] == b'C', message[:2]
+        if kind == 'K':
+            state[:len(message) - 2] = message[2:]
+        else:
+            # Bitmap with one bit per schema element, then the values of the set elements in order
+            bitmap_size = (num_elements + 7) // 8
+            bitmap = message[2:2 + bitmap_size]
+            position = 2 + bitmap_size
+            for element, (offset, size) in enumerate(elements):
+                if bitmap[element // 8] >> (element % 8) & 1:
+                    state[offset:offset + size] = message[position:position + size]
+                    position += size
+            assert position == len(message), (position, len(message))
+
+        packet_id = struct.unpack_from('<i', state, by_name['packetId'][0])[0]
+        for name, values in expected(fields, packet_id).items():
+            offset, field_type, count = by_name[name]
+            actual = list(struct.unpack_from('<%d%s' % (count, TYPE_FORMATS[field_type]), state, offset))
+            assert actual == values, (packet_id, name, actual, values)
+        if previous_id is not None:
+            assert packet_id > previous_id, (previous_id, packet_id)
+            gaps += packet_id - previous_id > 1
+        previous_id = packet_id
+
+    sock.sendall(bytes([0x88, 0x80, 1, 2, 3, 4]))  # Masked close frame
+    while True:
+        opcode, _ = read_frame(sock)
+        if opcode == 0x8:
+            break
+
+    frames = counts['K'] + counts['D']
+    print('%s: %d keyframes, %d deltas, %.1f bytes per frame, %d skips'
+          % ('slow' if slow else 'fast', counts['K'], counts['D'], total_bytes / frames, gaps))
+    assert counts['K'] >= 1 and counts['D'] > 0
+    assert not slow or gaps > 0, 'slow client was never skipped'
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,72 @@
+// Broadcasts synthetic packets at 60Hz on ws://127.0.0.1:PORT for loopbackclient.py, see run.sh.
+// Packet i has packetId i and every other field derived from i, so clients can check each frame.
+// The fields that change every frame while driving (LIVE_FLOATS, the counters and the pedals) all
+// change in every packet here too, so the measured frame sizes match real telemetry.
+
+#include "GT7WebSocketServer.h"
+#include <cstdlib>
+#include <thread>
+
+// Keep in sync with loopbackclient.py
+const char* const LIVE_FLOATS[] = {
+    "position", "worldVelocity", "rotation", "orientationRelativeToNorth", "angularVelocity", "bodyHeight",
+    "EngineRPM", "fuelLevel", "speed", "boost", "oilPressure", "tyreTemp", "roadPlane", "roadPlaneDistance",
+    "wheelRPS", "suspHeight", "UNKNOWNFLOATS", "RPMFromClutchToGearbox", "wheelRotation", "steeringAngularVelocity",
+    "sway", "heave", "surge", "torqueVectors", "wheelSteeringAngle"
+};
+
+bool isLiveFloat(const char* name) {
+    for (const char* live : LIVE_FLOATS) {
+        if (strcmp(name, live) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void fillPacket(PacketC& packet, int32_t i) {
+    memset(&packet, 0, sizeof(packet));
+    packet.magic = 0x47375330;
+    packet.fuelCapacity = 100.0f;
+    packet.gearRatios[0] = 3.5f;
+    packet.carCode = 1234;
+    packet.packetId = i;
+    packet.dayProgression = 3600000 + i * 16;
+    packet.currentLap = i * 16 % 90000;
+    packet.lapCount = static_cast<int16_t>(i / 600);
+    packet.gears = static_cast<uint8_t>(1 + i / 120 % 6);
+    packet.throttle = static_cast<uint8_t>(i * 3);
+    packet.brake = static_cast<uint8_t>(i * 5);
+    packet.throttleFiltered = static_cast<uint8_t>(i * 3 - 1);
+    packet.brakeFiltered = static_cast<uint8_t>(i * 5 - 1);
+
+    // Live float j holds a multiple of 1/8, exact in a float and in Python
+    uint8_t* data = reinterpret_cast<uint8_t*>(&packet);
+    int32_t j = 0;
+    for (const PacketField& field : GT7_PACKET_FIELDS) {
+        if (field.type != FieldType::Float32 || !isLiveFloat(field.name)) {
+            continue;
+        }
+        for (uint8_t element = 0; element < field.count; ++element, ++j) {
+            float value = ((i * (j + 1) + j * 37) % 4093) * 0.125f;
+            memcpy(&data[field.offset + element * 4], &value, sizeof(value));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const uint16_t port = argc > 1 ? static_cast<uint16_t>(atoi(argv[1])) : 18080;
+    const unsigned long duration = argc > 2 ? strtoul(argv[2], nullptr, 10) : 6000;
+
+    GT7_WebSocket_Server server(port);
+    server.begin();
+    PacketC packet;
+    const unsigned long start = millis();
+    for (int32_t i = 0; millis() - start < duration; ++i) {
+        server.poll();
+        fillPacket(packet, i);
+        server.broadcast(packet, 'C');
+        std::this_thread::sleep_for(std::chrono::microseconds(GT7_FRAME_MICROS));
+    }
+    return 0;
+}
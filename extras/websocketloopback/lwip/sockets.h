@@ -0,0 +1,33 @@
+// Host stand-in for lwIP, which provides the BSD socket API on ESP32
+
+#pragma once
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#if defined(LOOPBACK_ALWAYS_WRITABLE) && defined(__linux__)
+#include <linux/sockios.h>
+
+// run.sh also builds with LOOPBACK_ALWAYS_WRITABLE: select() then reports every socket writable and
+// send() refuses (EAGAIN, nothing written) any frame that no longer fits in LOOPBACK_SEND_LIMIT, so
+// a full send buffer is only discovered by send() itself
+constexpr int LOOPBACK_SEND_LIMIT = 2048;
+
+inline int loopbackSelect(int, fd_set*, fd_set*, fd_set*, struct timeval*) {
+    return 1;
+}
+
+inline ssize_t loopbackSend(int fd, const void* buffer, size_t size, int flags) {
+    int queued = 0;
+    if (ioctl(fd, SIOCOUTQ, &queued) == 0 && queued + static_cast<int>(size) > LOOPBACK_SEND_LIMIT) {
+        errno = EAGAIN;
+        return -1;
+    }
+    return ::send(fd, buffer, size, flags);
+}
+
+#define select loopbackSelect
+#define send loopbackSend
+#endif
@@ -0,0 +1,29 @@
+#!/bin/sh
+# Builds loopbackserver.cpp against the host stand-ins (as ESP32) and checks it with a
+# normal and a slow client at the same time. Needs a C++11 compiler and python3.
+# The second pass, on Linux only, makes the stand-in select() always report writable, so
+# slow clients are only caught by send() failing with EAGAIN.
+set -e
+cd "$(dirname "$0")"
+BUILD="${TMPDIR:-/tmp}/gt7-websocket-loopback"
+PORT="${1:-18080}"
+
+check() {
+    c++ -std=c++11 -Wall -Wextra -DESP32 $1 -I. -I../../src -o "$BUILD" \
+        loopbackserver.cpp ../../src/GT7WebSocketServer.cpp ../../src/GT7DeltaStream.cpp \
+        ../../src/GT7Serializer.cpp ../../src/GT7Packets.cpp
+    "$BUILD" "$PORT" 8000 &
+    SERVER=$!
+    sleep 0.5
+    python3 loopbackclient.py "$PORT" &
+    FAST=$!
+    python3 loopbackclient.py "$PORT" --slow
+    wait $FAST
+    wait $SERVER
+}
+
+check ""
+if [ "$(uname)" = Linux ]; then
+    check -DLOOPBACK_ALWAYS_WRITABLE
+fi
+echo OK
@@ -0,0 +1,227 @@
+#include "GT7CaptureDecoder.h"
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+
+#include "GT7PacketFields.h"
+#include "Salsa20.h"
+#include <atomic>
+#include <fstream>
+#include <string.h>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t RECORD_HEADER_SIZE = 2; // uint16_t payload length
+constexpr size_t PACKETS_PER_BATCH = 4096; // Unit of work handed to a worker thread
+
+const char* typeName(FieldType type) {
+    switch (type) {
+        case FieldType::UInt8: return "uint8";
+        case FieldType::Char: return "char";
+        case FieldType::Int16: return "int16";
+        case FieldType::Int32: return "int32";
+        default: return "float32";
+    }
+}
+
+// Pre-sized, writable mapping of one output column
+struct ColumnFile {
+    int fd = -1;
+    uint8_t* data = nullptr;
+    size_t size = 0;
+
+    bool create(const std::string& fileName, size_t fileSize) {
+        size = fileSize;
+        fd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return false;
+        }
+        if (size == 0) {
+            return true;
+        }
+        void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        data = static_cast<uint8_t*>(mapping);
+        return true;
+    }
+
+    ~ColumnFile() {
+        if (data != nullptr) {
+            ::munmap(data, size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+}
+
+GT7_Capture_Decoder::GT7_Capture_Decoder() : data(nullptr), dataSize(0) {}
+
+GT7_Capture_Decoder::~GT7_Capture_Decoder() {
+    close();
+}
+
+bool GT7_Capture_Decoder::open(const std::string& fileName) {
+    close();
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Could not open capture file.";
+        return false;
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0) {
+        error = "Could not determine size of capture file.";
+        ::close(fd);
+        return false;
+    }
+
+    dataSize = static_cast<size_t>(fileStat.st_size);
+    if (dataSize != 0) {
+        void* mapping = ::mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            error = "Could not map capture file into memory.";
+            ::close(fd);
+            dataSize = 0;
+            return false;
+        }
+        data = static_cast<const uint8_t*>(mapping);
+        ::madvise(mapping, dataSize, MADV_SEQUENTIAL);
+    }
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+
+    // Index pass: only the length headers are touched, decoding happens later in parallel
+    size_t position = 0;
+    while (position + RECORD_HEADER_SIZE <= dataSize) {
+        size_t length = data[position] | (static_cast<size_t>(data[position + 1]) << 8);
+        position += RECORD_HEADER_SIZE;
+        if (length > sizeof(PacketC) || position + length > dataSize) {
+            error = "Capture file contains a corrupt or truncated record.";
+            close();
+            return false;
+        }
+        recordOffsets.push_back(position);
+        position += length;
+    }
+
+    if (position != dataSize) {
+        error = "Capture file ends in the middle of a record header.";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void GT7_Capture_Decoder::close() {
+    if (data != nullptr) {
+        ::munmap(const_cast<uint8_t*>(data), dataSize);
+    }
+    data = nullptr;
+    dataSize = 0;
+    recordOffsets.clear();
+}
+
+size_t GT7_Capture_Decoder::getNumPackets() const {
+    return recordOffsets.size();
+}
+
+char GT7_Capture_Decoder::decodePacket(size_t index, PacketC& packet) const {
+    const uint8_t* record = &data[recordOffsets[index]];
+    size_t length = record[-2] | (static_cast<size_t>(record[-1]) << 8);
+
+    // Short records are zero padded so the IV read at 0x40 behaves like readData()
+    uint8_t encrypted[sizeof(PacketC)];
+    memset(encrypted, 0, sizeof(encrypted));
+    memcpy(encrypted, record, length);
+
+    char packetVersion = detectPacketVersion(static_cast<int>(length));
+    uint8_t iv[8];
+    buildPacketIv(encrypted, packetVersion, iv);
+
+    ucstk::Salsa20 salsa20(GT7_KEY);
+    salsa20.setIv(iv);
+
+    memset(&packet, 0, sizeof(packet));
+    salsa20.processBytes(encrypted, reinterpret_cast<uint8_t*>(&packet), length);
+    return packetVersion;
+}
+
+bool GT7_Capture_Decoder::writeColumns(const std::string& outputPrefix, unsigned int numThreads) {
+    const size_t numPackets = getNumPackets();
+
+    // One extra column holds the packet version of each row
+    std::vector<ColumnFile> files(GT7_NUM_PACKET_FIELDS + 1);
+    for (size_t i = 0; i < GT7_NUM_PACKET_FIELDS; ++i) {
+        const PacketField& field = GT7_PACKET_FIELDS[i];
+        if (!files[i].create(outputPrefix + "." + field.name + ".bin", numPackets * field.size())) {
+            error = std::string("Could not create output column ") + field.name + ".";
+            return false;
+        }
+    }
+    ColumnFile& versionFile = files.back();
+    if (!versionFile.create(outputPrefix + ".packetVersion.bin", numPackets)) {
+        error = "Could not create output column packetVersion.";
+        return false;
+    }
+
+    std::ofstream schema(outputPrefix + ".schema.csv");
+    if (!schema) {
+        error = "Could not create schema file.";
+        return false;
+    }
+    schema << "name,type,count,rows\n";
+    for (const PacketField& field : GT7_PACKET_FIELDS) {
+        schema << field.name << ',' << typeName(field.type) << ',' << static_cast<int>(field.count) << ',' << numPackets << '\n';
+    }
+    schema << "packetVersion,char,1," << numPackets << '\n';
+
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    const size_t numBatches = (numPackets + PACKETS_PER_BATCH - 1) / PACKETS_PER_BATCH;
+    if (numThreads > numBatches) {
+        numThreads = static_cast<unsigned int>(numBatches);
+    }
+
+    // Row i of every column is record i of the capture, so batches can finish in any order
+    std::atomic<size_t> nextBatch(0);
+    auto worker = [&]() {
+        PacketC packet;
+        for (size_t batch = nextBatch++; batch < numBatches; batch = nextBatch++) {
+            const size_t end = (batch + 1) * PACKETS_PER_BATCH < numPackets ? (batch + 1) * PACKETS_PER_BATCH : numPackets;
+            for (size_t row = batch * PACKETS_PER_BATCH; row < end; ++row) {
+                versionFile.data[row] = static_cast<uint8_t>(decodePacket(row, packet));
+                const uint8_t* source = reinterpret_cast<const uint8_t*>(&packet);
+                for (size_t i = 0; i < GT7_NUM_PACKET_FIELDS; ++i) {
+                    const size_t width = GT7_PACKET_FIELDS[i].size();
+                    memcpy(&files[i].data[row * width], &source[GT7_PACKET_FIELDS[i].offset], width);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return true;
+}
+
+const std::string& GT7_Capture_Decoder::getError() const {
+    return error;
+}
+
+#endif
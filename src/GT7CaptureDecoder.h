@@ -0,0 +1,37 @@
+#ifndef GT7CAPTUREDECODER_H
+#define GT7CAPTUREDECODER_H
+
+// Offline decoder for captured GT7 datagrams, only available on hosts with POSIX memory mapping.
+// A capture file is a sequence of records: a little-endian uint16_t length followed by that many
+// encrypted bytes, exactly as received from the console.
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+
+#include "GT7Packets.h"
+#include <string>
+#include <vector>
+
+class GT7_Capture_Decoder {
+    public:
+        GT7_Capture_Decoder();
+        ~GT7_Capture_Decoder();
+        GT7_Capture_Decoder(const GT7_Capture_Decoder&) = delete;
+        GT7_Capture_Decoder& operator=(const GT7_Capture_Decoder&) = delete;
+
+        bool open(const std::string& fileName); // Maps the capture and indexes its records
+        void close();
+        size_t getNumPackets() const;
+        char decodePacket(size_t index, PacketC& packet) const; // Returns the packet version, fields past the packet size are zeroed
+        bool writeColumns(const std::string& outputPrefix, unsigned int numThreads = 0); // 0: use all cores
+        const std::string& getError() const;
+
+    private:
+        const uint8_t* data;
+        size_t dataSize;
+        std::vector<size_t> recordOffsets; // Offset of each record's payload in the mapping
+        std::string error;
+};
+
+#endif
+
+#endif
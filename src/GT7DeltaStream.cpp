@@ -0,0 +1,193 @@
+#include "GT7DeltaStream.h"
+#include <string.h>
+
+namespace {
+
+const char WEBSOCKET_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Minimal SHA-1, only used for the WebSocket handshake
+class Sha1 {
+    public:
+        Sha1() : length(0), bufferLength(0) {
+            state[0] = 0x67452301;
+            state[1] = 0xEFCDAB89;
+            state[2] = 0x98BADCFE;
+            state[3] = 0x10325476;
+            state[4] = 0xC3D2E1F0;
+        }
+
+        void update(const uint8_t* data, size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                buffer[bufferLength++] = data[i];
+                if (bufferLength == 64) {
+                    processBlock();
+                    bufferLength = 0;
+                }
+            }
+            length += size;
+        }
+
+        void finish(uint8_t digest[20]) {
+            uint64_t bitLength = length * 8;
+            uint8_t padding = 0x80;
+            update(&padding, 1);
+            padding = 0;
+            while (bufferLength != 56) {
+                update(&padding, 1);
+            }
+            uint8_t lengthBytes[8];
+            for (uint8_t i = 0; i < 8; ++i) {
+                lengthBytes[i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+            }
+            update(lengthBytes, 8);
+            for (uint8_t i = 0; i < 20; ++i) {
+                digest[i] = static_cast<uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
+            }
+        }
+
+    private:
+        static uint32_t rotate(uint32_t value, uint8_t bits) {
+            return (value << bits) | (value >> (32 - bits));
+        }
+
+        void processBlock() {
+            uint32_t w[80];
+            for (uint8_t i = 0; i < 16; ++i) {
+                w[i] = (static_cast<uint32_t>(buffer[4 * i]) << 24) | (static_cast<uint32_t>(buffer[4 * i + 1]) << 16) |
+                       (static_cast<uint32_t>(buffer[4 * i + 2]) << 8) | buffer[4 * i + 3];
+            }
+            for (uint8_t i = 16; i < 80; ++i) {
+                w[i] = rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+            for (uint8_t i = 0; i < 80; ++i) {
+                uint32_t f, k;
+                if (i < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5A827999;
+                } else if (i < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ED9EBA1;
+                } else if (i < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8F1BBCDC;
+                } else {
+                    f = b ^ c ^ d;
+                    k = 0xCA62C1D6;
+                }
+                uint32_t temp = rotate(a, 5) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = rotate(b, 30);
+                b = a;
+                a = temp;
+            }
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+        }
+
+        uint32_t state[5];
+        uint64_t length;
+        uint8_t buffer[64];
+        uint8_t bufferLength;
+};
+
+}
+
+size_t encodeTelemetryKeyframe(uint8_t* buffer, size_t capacity, const PacketC& packet, char packetVersion) {
+    const int packetSize = getPacketSize(packetVersion);
+    if (packetSize == 0 || capacity < 2 + static_cast<size_t>(packetSize)) {
+        return 0;
+    }
+    buffer[0] = GT7_STREAM_KEYFRAME;
+    buffer[1] = static_cast<uint8_t>(packetVersion);
+    memcpy(&buffer[2], &packet, packetSize);
+    return 2 + packetSize;
+}
+
+size_t encodeTelemetryDelta(uint8_t* buffer, size_t capacity, const PacketC& baseline, const PacketC& packet, char packetVersion) {
+    const int packetSize = getPacketSize(packetVersion);
+    const size_t limit = capacity < 2 + static_cast<size_t>(packetSize) ? capacity : 2 + packetSize; // Never larger than a keyframe
+    const size_t numFields = gt7NumFieldsForSize(packetSize);
+    const uint8_t* previous = reinterpret_cast<const uint8_t*>(&baseline);
+    const uint8_t* current = reinterpret_cast<const uint8_t*>(&packet);
+
+    size_t numElements = 0;
+    for (size_t field = 0; field < numFields; ++field) {
+        numElements += GT7_PACKET_FIELDS[field].count;
+    }
+    const size_t bitmapSize = (numElements + 7) / 8;
+    if (packetSize == 0 || limit < 2 + bitmapSize) {
+        return 0;
+    }
+    buffer[0] = GT7_STREAM_DELTA;
+    buffer[1] = static_cast<uint8_t>(packetVersion);
+    uint8_t* bitmap = &buffer[2];
+    memset(bitmap, 0, bitmapSize);
+    size_t length = 2 + bitmapSize;
+
+    size_t element = 0;
+    for (size_t field = 0; field < numFields; ++field) {
+        const PacketField& info = GT7_PACKET_FIELDS[field];
+        if (memcmp(&previous[info.offset], &current[info.offset], info.size()) == 0) {
+            element += info.count; // Most fields (gearRatios, carCode, fuelCapacity...) are skipped here in one compare
+            continue;
+        }
+        const uint8_t elementSize = fieldTypeSize(info.type);
+        for (uint8_t i = 0; i < info.count; ++i, ++element) {
+            const size_t offset = info.offset + i * elementSize;
+            if (memcmp(&previous[offset], &current[offset], elementSize) == 0) {
+                continue;
+            }
+            if (length + elementSize >= limit) {
+                return 0;
+            }
+            bitmap[element / 8] |= static_cast<uint8_t>(1 << (element % 8));
+            memcpy(&buffer[length], &current[offset], elementSize);
+            length += elementSize;
+        }
+    }
+    return length;
+}
+
+bool computeWebSocketAccept(const char* clientKey, size_t keyLength, char accept[GT7_WEBSOCKET_ACCEPT_SIZE]) {
+    if (keyLength == 0 || keyLength > 64) {
+        return false;
+    }
+    Sha1 sha1;
+    sha1.update(reinterpret_cast<const uint8_t*>(clientKey), keyLength);
+    sha1.update(reinterpret_cast<const uint8_t*>(WEBSOCKET_GUID), sizeof(WEBSOCKET_GUID) - 1);
+    uint8_t digest[21];
+    sha1.finish(digest);
+    digest[20] = 0;
+
+    // 20 bytes encode to 27 characters plus one '=' of padding
+    size_t position = 0;
+    for (uint8_t i = 0; i < 21; i += 3) {
+        uint32_t group = (static_cast<uint32_t>(digest[i]) << 16) | (static_cast<uint32_t>(digest[i + 1]) << 8) | digest[i + 2];
+        accept[position++] = BASE64_ALPHABET[(group >> 18) & 0x3F];
+        accept[position++] = BASE64_ALPHABET[(group >> 12) & 0x3F];
+        accept[position++] = BASE64_ALPHABET[(group >> 6) & 0x3F];
+        accept[position++] = BASE64_ALPHABET[group & 0x3F];
+    }
+    accept[27] = '=';
+    accept[28] = '\0';
+    return true;
+}
+
+size_t writeWebSocketHeader(uint8_t* buffer, uint8_t opcode, size_t payloadLength) {
+    buffer[0] = 0x80 | (opcode & 0x0F);
+    if (payloadLength < 126) {
+        buffer[1] = static_cast<uint8_t>(payloadLength);
+        return 2;
+    }
+    buffer[1] = 126;
+    buffer[2] = static_cast<uint8_t>(payloadLength >> 8);
+    buffer[3] = static_cast<uint8_t>(payloadLength);
+    return 4;
+}
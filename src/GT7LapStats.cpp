@@ -0,0 +1,230 @@
+#include "GT7LapStats.h"
+#include <math.h>
+
+constexpr uint16_t IGNORED_FLAGS = static_cast<uint16_t>(SimulatorFlags::Paused) | static_cast<uint16_t>(SimulatorFlags::LoadingOrProcessing);
+
+// Default histogram ranges, one row per StatChannel
+const float DEFAULT_RANGES[GT7_NUM_STAT_CHANNELS][2] = {
+    {0.0f, 16000.0f}, // EngineRPM, 1000 RPM per bucket
+    {0.0f, 256.0f}, // throttle
+    {0.0f, 256.0f}, // brake
+    {0.0f, 96.0f}, // speed, 6 m/s per bucket
+    {0.0f, 160.0f}, {0.0f, 160.0f}, {0.0f, 160.0f}, {0.0f, 160.0f}, // tyreTemp, 10 degrees per bucket
+    {0.0f, 0.32f}, {0.0f, 0.32f}, {0.0f, 0.32f}, {0.0f, 0.32f} // suspHeight
+};
+
+void RunningStat::reset() {
+    count = 0;
+    minimum = 0.0f;
+    maximum = 0.0f;
+    mean = 0.0f;
+    m2 = 0.0f;
+}
+
+void RunningStat::add(float value) {
+    if (count == 0) {
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    ++count;
+    float delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+float RunningStat::variance() const {
+    return count > 1 ? m2 / (count - 1) : 0.0f;
+}
+
+float RunningStat::standardDeviation() const {
+    return sqrtf(variance());
+}
+
+void LapSummary::reset(int16_t lap) {
+    lapNumber = lap;
+    lapTime = -1;
+    frames = 0;
+    fuelUsed = 0.0f;
+    for (uint8_t gear = 0; gear < GT7_NUM_GEARS; ++gear) {
+        gearFrames[gear] = 0;
+    }
+    for (uint8_t channel = 0; channel < GT7_NUM_STAT_CHANNELS; ++channel) {
+        stats[channel].reset();
+        for (uint8_t bucket = 0; bucket < GT7_STAT_BUCKETS; ++bucket) {
+            histograms[channel][bucket] = 0;
+        }
+    }
+}
+
+const RunningStat& LapSummary::getStat(StatChannel channel) const {
+    return stats[static_cast<uint8_t>(channel)];
+}
+
+const uint32_t* LapSummary::getHistogram(StatChannel channel) const {
+    return histograms[static_cast<uint8_t>(channel)];
+}
+
+float LapSummary::getSeconds() const {
+    return frames * (GT7_FRAME_MICROS / 1000000.0f);
+}
+
+float LapSummary::getGearSeconds(uint8_t gear) const {
+    return gear < GT7_NUM_GEARS ? gearFrames[gear] * (GT7_FRAME_MICROS / 1000000.0f) : 0.0f;
+}
+
+GT7_Lap_Stats::GT7_Lap_Stats() : lapsCompleted(0) {
+    for (uint8_t channel = 0; channel < GT7_NUM_STAT_CHANNELS; ++channel) {
+        setHistogramRange(static_cast<StatChannel>(channel), DEFAULT_RANGES[channel][0], DEFAULT_RANGES[channel][1]);
+    }
+    reset();
+}
+
+void GT7_Lap_Stats::setHistogramRange(StatChannel channel, float lowerBound, float upperBound) {
+    uint8_t index = static_cast<uint8_t>(channel);
+    if (index >= GT7_NUM_STAT_CHANNELS || !(upperBound > lowerBound)) {
+        return;
+    }
+    lower[index] = lowerBound;
+    scale[index] = GT7_STAT_BUCKETS / (upperBound - lowerBound);
+}
+
+float GT7_Lap_Stats::getBucketLower(StatChannel channel, uint8_t bucket) {
+    uint8_t index = static_cast<uint8_t>(channel);
+    return index < GT7_NUM_STAT_CHANNELS ? lower[index] + bucket / scale[index] : 0.0f;
+}
+
+void GT7_Lap_Stats::reset() {
+    current = 0;
+    numLaps = 0;
+    laps[current].reset(-1);
+    stint.reset(-1);
+    previousPacketId = 0;
+    previousFuel = 0.0f;
+    hasPrevious = false;
+}
+
+void GT7_Lap_Stats::startStint() {
+    stint.reset(-1);
+}
+
+const LapSummary& GT7_Lap_Stats::getCurrentLap() {
+    return laps[current];
+}
+
+const LapSummary& GT7_Lap_Stats::getStint() {
+    return stint;
+}
+
+uint8_t GT7_Lap_Stats::getNumLaps() {
+    return numLaps;
+}
+
+uint32_t GT7_Lap_Stats::getLapsCompleted() {
+    return lapsCompleted;
+}
+
+const LapSummary* GT7_Lap_Stats::getLap(uint8_t age) {
+    if (age >= numLaps) {
+        return nullptr;
+    }
+    return &laps[(current + MAX_LAPS - age) % (MAX_LAPS + 1)];
+}
+
+float GT7_Lap_Stats::getAverageFuelPerLap(uint8_t count) {
+    if (count > numLaps) {
+        count = numLaps;
+    }
+    if (count == 0) {
+        return 0.0f;
+    }
+    float fuelUsed = 0.0f;
+    for (uint8_t age = 0; age < count; ++age) {
+        fuelUsed += getLap(age)->fuelUsed;
+    }
+    return fuelUsed / count;
+}
+
+void GT7_Lap_Stats::addSample(LapSummary& summary, uint8_t channel, float value, uint8_t bucket) {
+    summary.stats[channel].add(value);
+    ++summary.histograms[channel][bucket];
+}
+
+void GT7_Lap_Stats::update(const PacketC& packet) {
+    if (hasPrevious && packet.packetId == previousPacketId) {
+        return;
+    }
+    if (static_cast<uint16_t>(packet.flags) & IGNORED_FLAGS) {
+        hasPrevious = false; // Time does not pass in menus, the next packet counts as a single frame
+        return;
+    }
+
+    LapSummary* lap = &laps[current];
+    if (packet.lapCount != lap->lapNumber) {
+        if (lap->frames == 0) {
+            lap->lapNumber = packet.lapCount; // Nothing driven yet
+        } else if (packet.lapCount < lap->lapNumber) {
+            reset(); // Restarted or a new session
+            lap = &laps[current];
+            lap->lapNumber = packet.lapCount;
+        } else {
+            if (lap->lapNumber > 0) {
+                // Keep the completed lap, the slot after it becomes the current lap
+                lap->lapTime = packet.lastLaptime;
+                current = (current + 1) % (MAX_LAPS + 1);
+                if (numLaps < MAX_LAPS) {
+                    ++numLaps;
+                }
+                ++lapsCompleted;
+            }
+            lap = &laps[current];
+            lap->reset(packet.lapCount);
+        }
+    }
+
+    // Each packet stands for the frames since the previous one, so dropped packets still count as driving time
+    int32_t frames = 1;
+    float fuelUsed = 0.0f;
+    if (hasPrevious) {
+        frames = packet.packetId - previousPacketId;
+        if (frames < 1) {
+            frames = 1;
+        } else if (frames > MAX_GAP_FRAMES) {
+            frames = MAX_GAP_FRAMES;
+        }
+        if (packet.fuelLevel < previousFuel) {
+            fuelUsed = previousFuel - packet.fuelLevel;
+        }
+    }
+    previousPacketId = packet.packetId;
+    previousFuel = packet.fuelLevel;
+    hasPrevious = true;
+
+    uint8_t gear = packet.gears & 0b00001111;
+    lap->frames += frames;
+    lap->gearFrames[gear] += frames;
+    lap->fuelUsed += fuelUsed;
+    stint.frames += frames;
+    stint.gearFrames[gear] += frames;
+    stint.fuelUsed += fuelUsed;
+
+    const float values[GT7_NUM_STAT_CHANNELS] = {
+        packet.EngineRPM, static_cast<float>(packet.throttle), static_cast<float>(packet.brake), packet.speed,
+        packet.tyreTemp[0], packet.tyreTemp[1], packet.tyreTemp[2], packet.tyreTemp[3],
+        packet.suspHeight[0], packet.suspHeight[1], packet.suspHeight[2], packet.suspHeight[3]
+    };
+    for (uint8_t channel = 0; channel < GT7_NUM_STAT_CHANNELS; ++channel) {
+        float position = (values[channel] - lower[channel]) * scale[channel];
+        uint8_t bucket = 0;
+        if (position >= GT7_STAT_BUCKETS) {
+            bucket = GT7_STAT_BUCKETS - 1;
+        } else if (position > 0.0f) {
+            bucket = static_cast<uint8_t>(position);
+        }
+        addSample(*lap, channel, values[channel], bucket);
+        addSample(stint, channel, values[channel], bucket);
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef GT7LAPSTATS_H
+#define GT7LAPSTATS_H
+
+// Running per-lap and per-stint statistics without storing samples. Every update() is O(1) and
+// all memory is allocated up front, about 1.1kB per kept lap. Floats are used rather than doubles
+// as only the float unit of the ESP32 is in hardware.
+
+#include <inttypes.h>
+#include "GT7Packets.h"
+
+#ifndef GT7_LAP_STATS_HISTORY
+#define GT7_LAP_STATS_HISTORY 8 // Completed laps kept, override in your build flags
+#endif
+
+enum class StatChannel : uint8_t {
+    EngineRPM,
+    throttle,
+    brake,
+    speed, // m/s
+    tyreTempFL,
+    tyreTempFR,
+    tyreTempRL,
+    tyreTempRR,
+    suspHeightFL,
+    suspHeightFR,
+    suspHeightRL,
+    suspHeightRR
+};
+
+constexpr uint8_t GT7_NUM_STAT_CHANNELS = 12;
+constexpr uint8_t GT7_STAT_BUCKETS = 16;
+constexpr uint8_t GT7_NUM_GEARS = 16; // Lower 4 bits of gears, 0 is neutral/reverse
+
+struct RunningStat {
+    uint32_t count;
+    float minimum;
+    float maximum;
+    float mean;
+    float m2; // Sum of squared differences from the mean (Welford)
+
+    void reset();
+    void add(float value);
+    float variance() const; // Sample variance, 0 with less than 2 samples
+    float standardDeviation() const;
+};
+
+struct LapSummary {
+    int16_t lapNumber; // lapCount while the lap was driven, -1 for a stint
+    int32_t lapTime; // lastLaptime reported when the lap was completed in ms, -1 if not set
+    uint32_t frames; // Frames driven, from packetId, see getSeconds
+    float fuelUsed; // Liters, refuelling is not subtracted
+    uint32_t gearFrames[GT7_NUM_GEARS]; // Frames spent in each gear
+    RunningStat stats[GT7_NUM_STAT_CHANNELS];
+    uint32_t histograms[GT7_NUM_STAT_CHANNELS][GT7_STAT_BUCKETS]; // Samples per bucket, see GT7_Lap_Stats::getBucketLower
+
+    void reset(int16_t lap);
+    const RunningStat& getStat(StatChannel channel) const;
+    const uint32_t* getHistogram(StatChannel channel) const;
+    float getSeconds() const;
+    float getGearSeconds(uint8_t gear) const;
+};
+
+class GT7_Lap_Stats {
+    public:
+        static constexpr uint8_t MAX_LAPS = GT7_LAP_STATS_HISTORY;
+        static constexpr int32_t MAX_GAP_FRAMES = 30; // Longer packetId gaps (connection loss) only count this many frames
+
+        GT7_Lap_Stats();
+        void setHistogramRange(StatChannel channel, float lowerBound, float upperBound); // Values outside land in the first/last bucket, applies to new samples only
+        float getBucketLower(StatChannel channel, uint8_t bucket);
+        void update(const PacketC& packet); // Call after every readData(), one sample per packet, repeated, paused and loading packets are ignored
+        const LapSummary& getCurrentLap();
+        const LapSummary& getStint(); // Everything since the last startStint(), including the current lap
+        uint8_t getNumLaps(); // Completed laps kept, up to MAX_LAPS
+        uint32_t getLapsCompleted(); // Only ever increases, not even reset(), compare with a previous value to spot a new lap
+        const LapSummary* getLap(uint8_t age); // 0: last completed lap, nullptr if not kept
+        float getAverageFuelPerLap(uint8_t count = MAX_LAPS); // Over the last completed laps, 0 if there are none
+        void startStint(); // E.g. after a pit stop, keeps the completed laps
+        void reset(); // Forget all laps and the stint
+
+    private:
+        void addSample(LapSummary& summary, uint8_t channel, float value, uint8_t bucket);
+
+        LapSummary laps[MAX_LAPS + 1]; // Ring, laps[current] is the lap being driven
+        LapSummary stint;
+        float lower[GT7_NUM_STAT_CHANNELS];
+        float scale[GT7_NUM_STAT_CHANNELS]; // Buckets per unit
+        uint8_t current;
+        uint8_t numLaps;
+        uint32_t lapsCompleted;
+        int32_t previousPacketId;
+        float previousFuel;
+        bool hasPrevious;
+};
+
+#endif
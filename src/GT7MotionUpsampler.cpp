@@ -0,0 +1,144 @@
+#include "GT7MotionUpsampler.h"
+#include <string.h>
+
+static_assert(sizeof(MotionState) == 16 * sizeof(float), "MotionState must only contain floats");
+
+constexpr int32_t RESYNC_MICROS = 1000000; // Larger clock disagreements mean a new session or a packetId reset
+constexpr int32_t OFFSET_DRIFT_DIVISOR = 64; // How quickly the clock offset follows slower packets
+constexpr int32_t REORDER_FRAMES = 60; // Packets up to this far behind the newest one arrived out of order, further back is a new session
+
+GT7_Motion_Upsampler::GT7_Motion_Upsampler() : leadMicros(0), maxExtrapolationMicros(100000), smoothing(0.0f) {
+    reset();
+}
+
+void GT7_Motion_Upsampler::setLatencyCompensation(int32_t lead) {
+    leadMicros = lead;
+}
+
+void GT7_Motion_Upsampler::setSmoothing(float value) {
+    if (value < 0.0f) {
+        value = 0.0f;
+    } else if (value > 0.99f) {
+        value = 0.99f;
+    }
+    smoothing = value;
+}
+
+void GT7_Motion_Upsampler::setMaxExtrapolation(uint32_t maxMicros) {
+    maxExtrapolationMicros = maxMicros;
+}
+
+void GT7_Motion_Upsampler::reset() {
+    memset(frames, 0, sizeof(frames));
+    memset(&output, 0, sizeof(output));
+    packetIds[0] = packetIds[1] = 0;
+    numFrames = 0;
+    clockOffset = 0;
+    predictionMicros = 0;
+    hasOutput = false;
+}
+
+uint32_t GT7_Motion_Upsampler::frameTime(int32_t packetId) {
+    // Unsigned arithmetic wraps consistently with micros(), only differences are ever used
+    return static_cast<uint32_t>(packetId) * GT7_FRAME_MICROS + clockOffset;
+}
+
+void GT7_Motion_Upsampler::push(const PacketC& packet, uint32_t receiveMicros) {
+    if (numFrames > 0 && packet.packetId <= packetIds[1] && packetIds[1] - packet.packetId < REORDER_FRAMES) {
+        return; // Repeated, or reordered by Wi-Fi and already superseded by a newer packet
+    }
+
+    // Game time comes from packetId, the receive time only anchors it to micros(). Network
+    // delay can only make packets late, so the offset follows early packets immediately and
+    // late ones slowly, which keeps Wi-Fi jitter out of the output.
+    uint32_t rawOffset = receiveMicros - static_cast<uint32_t>(packet.packetId) * GT7_FRAME_MICROS;
+    int32_t difference = static_cast<int32_t>(rawOffset - clockOffset);
+    if (numFrames == 0 || packet.packetId < packetIds[1] || difference > RESYNC_MICROS || difference < -RESYNC_MICROS) {
+        numFrames = 0;
+        clockOffset = rawOffset;
+    } else if (difference < 0) {
+        clockOffset = rawOffset;
+    } else {
+        clockOffset += (difference + OFFSET_DRIFT_DIVISOR - 1) / OFFSET_DRIFT_DIVISOR;
+    }
+
+    frames[0] = frames[1];
+    packetIds[0] = packetIds[1];
+
+    MotionState& frame = frames[1];
+    memcpy(frame.position, packet.position, sizeof(frame.position));
+    memcpy(frame.worldVelocity, packet.worldVelocity, sizeof(frame.worldVelocity));
+    memcpy(frame.rotation, packet.rotation, sizeof(frame.rotation));
+    memcpy(frame.angularVelocity, packet.angularVelocity, sizeof(frame.angularVelocity));
+    frame.sway = packet.sway;
+    frame.heave = packet.heave;
+    frame.surge = packet.surge;
+    frame.speed = packet.speed;
+    packetIds[1] = packet.packetId;
+
+    if (numFrames < 2) {
+        ++numFrames;
+    }
+}
+
+bool GT7_Motion_Upsampler::sample(uint32_t nowMicros, MotionState& state) {
+    if (numFrames == 0) {
+        return false;
+    }
+
+    const float* newest = reinterpret_cast<const float*>(&frames[1]);
+    const float* previous = reinterpret_cast<const float*>(&frames[0]);
+    float target[CHANNELS];
+
+    uint32_t newestTime = frameTime(packetIds[1]);
+    int32_t ahead = static_cast<int32_t>(nowMicros + leadMicros - newestTime);
+    if (ahead > static_cast<int32_t>(maxExtrapolationMicros)) {
+        ahead = static_cast<int32_t>(maxExtrapolationMicros);
+    }
+    predictionMicros = ahead;
+
+    if (numFrames < 2) {
+        memcpy(target, newest, sizeof(target));
+        if (ahead > 0) {
+            float dt = ahead * 1e-6f;
+            for (uint8_t axis = 0; axis < 3; ++axis) {
+                target[axis] += frames[1].worldVelocity[axis] * dt;
+            }
+        }
+    } else {
+        int32_t span = static_cast<int32_t>(newestTime - frameTime(packetIds[0]));
+        // Fraction along previous -> newest, 1.0 is the newest packet, above 1.0 extrapolates
+        float t = 1.0f + static_cast<float>(ahead) / static_cast<float>(span);
+        if (t < 0.0f) {
+            t = 0.0f;
+        }
+        for (uint8_t i = 0; i < CHANNELS; ++i) {
+            target[i] = previous[i] + (newest[i] - previous[i]) * t;
+        }
+        if (ahead > 0) {
+            // Dead reckon position from the reported velocity rather than the position trend
+            float dt = ahead * 1e-6f;
+            for (uint8_t axis = 0; axis < 3; ++axis) {
+                target[axis] = frames[1].position[axis] + frames[1].worldVelocity[axis] * dt;
+            }
+        }
+    }
+
+    float* smoothed = reinterpret_cast<float*>(&output);
+    if (!hasOutput || smoothing == 0.0f) {
+        memcpy(smoothed, target, sizeof(target));
+        hasOutput = true;
+    } else {
+        float weight = 1.0f - smoothing;
+        for (uint8_t i = 0; i < CHANNELS; ++i) {
+            smoothed[i] += (target[i] - smoothed[i]) * weight;
+        }
+    }
+
+    state = output;
+    return true;
+}
+
+int32_t GT7_Motion_Upsampler::getPredictionMicros(void) {
+    return predictionMicros;
+}
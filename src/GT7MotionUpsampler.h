@@ -0,0 +1,46 @@
+#ifndef GT7MOTIONUPSAMPLER_H
+#define GT7MOTIONUPSAMPLER_H
+
+#include <inttypes.h>
+#include "GT7Packets.h"
+
+struct MotionState {
+    float position[3]; // Position on Track in meters in each axis
+    float worldVelocity[3]; // Velocity in meters for each axis
+    float rotation[3]; // Rotation (Pitch/Yaw/Roll) (RANGE: -1 -> 1)
+    float angularVelocity[3]; // Speed at which the car turns around axis in rad/s
+    float sway; // X axis acceleration (0 for Packet A)
+    float heave; // Y axis acceleration (0 for Packet A)
+    float surge; // Z axis acceleration (0 for Packet A)
+    float speed; // Speed in m/s
+};
+
+class GT7_Motion_Upsampler {
+    public:
+        GT7_Motion_Upsampler();
+        void setLatencyCompensation(int32_t leadMicros); // > 0: predict ahead of the newest packet, < 0: interpolate between packets this far in the past
+        void setSmoothing(float smoothing); // 0.0: none -> 0.95: heavy, exponential smoothing applied per sample() call
+        void setMaxExtrapolation(uint32_t maxMicros); // State is held once the newest packet is older than this (default 100ms)
+        void push(const PacketC& packet, uint32_t receiveMicros); // Call for every new packet, e.g. with getReceiveMicros()
+        bool sample(uint32_t nowMicros, MotionState& state); // Call at the actuator rate, false until a packet has been pushed
+        int32_t getPredictionMicros(void); // How far the last sample() was ahead (> 0) or behind (< 0) the newest packet
+        void reset();
+
+    private:
+        static constexpr uint8_t CHANNELS = sizeof(MotionState) / sizeof(float);
+
+        uint32_t frameTime(int32_t packetId);
+
+        MotionState frames[2]; // 0: previous packet, 1: newest packet
+        MotionState output;
+        int32_t packetIds[2];
+        uint8_t numFrames;
+        uint32_t clockOffset; // Local micros() of packetId 0 along the fastest observed path
+        int32_t leadMicros;
+        uint32_t maxExtrapolationMicros;
+        float smoothing;
+        int32_t predictionMicros;
+        bool hasOutput;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef GT7PACKETFIELDS_H
+#define GT7PACKETFIELDS_H
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "GT7Packets.h"
+
+enum class FieldType : uint8_t {
+    UInt8 = 0,
+    Char = 1,
+    Int16 = 2,
+    Int32 = 3,
+    Float32 = 4
+};
+
+constexpr uint8_t fieldTypeSize(FieldType type) {
+    return (type == FieldType::UInt8 || type == FieldType::Char) ? 1 : (type == FieldType::Int16 ? 2 : 4);
+}
+
+struct PacketField {
+    const char* name; // Member name in PacketA -> PacketC
+    uint16_t offset; // Byte offset from the start of the packet
+    FieldType type; // Element type
+    uint8_t count; // Number of elements, 1 for scalars
+    const char* unit; // Unit of each element, empty if none
+
+    constexpr uint16_t size() const { return fieldTypeSize(type) * count; }
+    constexpr uint8_t firstBlock() const { return offset / 64; } // 64-byte Salsa20 block holding the first byte
+    constexpr uint8_t lastBlock() const { return (offset + size() - 1) / 64; } // Differs from firstBlock() if the field spans two blocks
+};
+
+// Every field of PacketC in declaration order, the table mirrors the structs in GT7Packets.h
+constexpr PacketField GT7_PACKET_FIELDS[] = {
+    {"magic", 0, FieldType::Int32, 1, ""},
+    {"position", 4, FieldType::Float32, 3, "m"},
+    {"worldVelocity", 16, FieldType::Float32, 3, "m/s"},
+    {"rotation", 28, FieldType::Float32, 3, ""},
+    {"orientationRelativeToNorth", 40, FieldType::Float32, 1, ""},
+    {"angularVelocity", 44, FieldType::Float32, 3, "rad/s"},
+    {"bodyHeight", 56, FieldType::Float32, 1, "m"},
+    {"EngineRPM", 60, FieldType::Float32, 1, "rpm"},
+    {"iv", 64, FieldType::UInt8, 4, ""},
+    {"fuelLevel", 68, FieldType::Float32, 1, "l"},
+    {"fuelCapacity", 72, FieldType::Float32, 1, "l"},
+    {"speed", 76, FieldType::Float32, 1, "m/s"},
+    {"boost", 80, FieldType::Float32, 1, "x100kPa+1"},
+    {"oilPressure", 84, FieldType::Float32, 1, "bar"},
+    {"waterTemp", 88, FieldType::Float32, 1, "degC"},
+    {"oilTemp", 92, FieldType::Float32, 1, "degC"},
+    {"tyreTemp", 96, FieldType::Float32, 4, "degC"},
+    {"packetId", 112, FieldType::Int32, 1, ""},
+    {"lapCount", 116, FieldType::Int16, 1, ""},
+    {"totalLaps", 118, FieldType::Int16, 1, ""},
+    {"bestLaptime", 120, FieldType::Int32, 1, "ms"},
+    {"lastLaptime", 124, FieldType::Int32, 1, "ms"},
+    {"dayProgression", 128, FieldType::Int32, 1, "ms"},
+    {"RaceStartPosition", 132, FieldType::Int16, 1, ""},
+    {"preRaceNumCars", 134, FieldType::Int16, 1, ""},
+    {"minAlertRPM", 136, FieldType::Int16, 1, "rpm"},
+    {"maxAlertRPM", 138, FieldType::Int16, 1, "rpm"},
+    {"calcMaxSpeed", 140, FieldType::Int16, 1, "km/h"},
+    {"flags", 142, FieldType::Int16, 1, ""},
+    {"gears", 144, FieldType::UInt8, 1, ""},
+    {"throttle", 145, FieldType::UInt8, 1, "0-255"},
+    {"brake", 146, FieldType::UInt8, 1, "0-255"},
+    {"PADDING", 147, FieldType::UInt8, 1, ""},
+    {"roadPlane", 148, FieldType::Float32, 3, ""},
+    {"roadPlaneDistance", 160, FieldType::Float32, 1, "m"},
+    {"wheelRPS", 164, FieldType::Float32, 4, "rad/s"},
+    {"tyreRadius", 180, FieldType::Float32, 4, "m"},
+    {"suspHeight", 196, FieldType::Float32, 4, "m"},
+    {"UNKNOWNFLOATS", 212, FieldType::Float32, 8, ""},
+    {"clutch", 244, FieldType::Float32, 1, "0-1"},
+    {"clutchEngagement", 248, FieldType::Float32, 1, "0-1"},
+    {"RPMFromClutchToGearbox", 252, FieldType::Float32, 1, "rpm"},
+    {"transmissionTopSpeed", 256, FieldType::Float32, 1, ""},
+    {"gearRatios", 260, FieldType::Float32, 8, ""},
+    {"carCode", 292, FieldType::Int32, 1, ""},
+    {"wheelRotation", 296, FieldType::Float32, 1, "rad"},
+    {"steeringAngularVelocity", 300, FieldType::Float32, 1, "rad/s"},
+    {"sway", 304, FieldType::Float32, 1, "m/s2"},
+    {"heave", 308, FieldType::Float32, 1, "m/s2"},
+    {"surge", 312, FieldType::Float32, 1, "m/s2"},
+    {"throttleFiltered", 316, FieldType::UInt8, 1, "0-255"},
+    {"brakeFiltered", 317, FieldType::UInt8, 1, "0-255"},
+    {"UNKNOWNUINT81", 318, FieldType::UInt8, 1, ""},
+    {"UNKNOWNUINT82", 319, FieldType::UInt8, 1, ""},
+    {"torqueVectors", 320, FieldType::Float32, 4, ""},
+    {"energyRecovery", 336, FieldType::Float32, 1, ""},
+    {"UNKNOWNFLOAT11", 340, FieldType::Float32, 1, ""},
+    {"surfaceType", 344, FieldType::Char, 4, ""},
+    {"currentLap", 348, FieldType::Int32, 1, "ms"},
+    {"wheelSteeringAngle", 352, FieldType::Float32, 2, "rad"},
+    {"wheelBase", 360, FieldType::Float32, 1, "m"},
+    {"carCategory", 364, FieldType::Char, 4, ""}
+};
+
+constexpr size_t GT7_NUM_PACKET_FIELDS = sizeof(GT7_PACKET_FIELDS) / sizeof(GT7_PACKET_FIELDS[0]);
+
+// Fields are packed, so every field must start where the previous one ends
+constexpr bool gt7PacketFieldsAreContiguous(size_t index = 1) {
+    return index >= GT7_NUM_PACKET_FIELDS ||
+        (GT7_PACKET_FIELDS[index].offset == GT7_PACKET_FIELDS[index - 1].offset + GT7_PACKET_FIELDS[index - 1].size() &&
+         gt7PacketFieldsAreContiguous(index + 1));
+}
+
+static_assert(GT7_PACKET_FIELDS[0].offset == 0, "Field table must start at the beginning of the packet");
+static_assert(gt7PacketFieldsAreContiguous(), "Field table has gaps or overlaps, check it against GT7Packets.h");
+static_assert(GT7_PACKET_FIELDS[GT7_NUM_PACKET_FIELDS - 1].offset + GT7_PACKET_FIELDS[GT7_NUM_PACKET_FIELDS - 1].size() == sizeof(PacketC),
+              "Field table does not cover PacketC");
+
+// Number of fields fully contained in a packet of the given version
+constexpr size_t gt7NumFieldsForSize(int packetSize, size_t index = 0) {
+    return (index < GT7_NUM_PACKET_FIELDS && GT7_PACKET_FIELDS[index].offset + GT7_PACKET_FIELDS[index].size() <= packetSize) ?
+        gt7NumFieldsForSize(packetSize, index + 1) : index;
+}
+
+static_assert(GT7_PACKET_FIELDS[gt7NumFieldsForSize(PACKET_A_SIZE)].offset == PACKET_A_SIZE, "PacketA fields do not end at the PacketA size");
+static_assert(GT7_PACKET_FIELDS[gt7NumFieldsForSize(PACKET_B_SIZE)].offset == PACKET_B_SIZE, "PacketB fields do not end at the PacketB size");
+static_assert(GT7_PACKET_FIELDS[gt7NumFieldsForSize(PACKET_TILDA_SIZE)].offset == PACKET_TILDA_SIZE, "PacketTilda fields do not end at the PacketTilda size");
+
+#endif
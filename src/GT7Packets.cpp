@@ -0,0 +1,54 @@
+#include "GT7Packets.h"
+#include <string.h>
+
+const uint8_t GT7_KEY[32] = {
+    'S', 'i', 'm', 'u', 'l', 'a', 't', 'o', 'r', ' ', 'I', 'n', 't', 'e', 'r', 'f',
+    'a', 'c', 'e', ' ', 'P', 'a', 'c', 'k', 'e', 't', ' ', 'G', 'T', '7', ' ', 'v'
+};
+
+static_assert(sizeof(PacketA) == PACKET_A_SIZE, "PacketA layout does not match the game");
+static_assert(sizeof(PacketB) == PACKET_B_SIZE, "PacketB layout does not match the game");
+static_assert(sizeof(PacketTilda) == PACKET_TILDA_SIZE, "PacketTilda layout does not match the game");
+static_assert(sizeof(PacketC) == PACKET_C_SIZE, "PacketC layout does not match the game");
+
+char detectPacketVersion(int packetSize) {
+    switch (packetSize) {
+        case PACKET_A_SIZE: return 'A';
+        case PACKET_B_SIZE: return 'B';
+        case PACKET_TILDA_SIZE: return '~';
+        case PACKET_C_SIZE: return 'C';
+        default: return ' ';
+    }
+}
+
+int getPacketSize(char packetVersion) {
+    switch (packetVersion) {
+        case 'A': return PACKET_A_SIZE;
+        case 'B': return PACKET_B_SIZE;
+        case '~': return PACKET_TILDA_SIZE;
+        case 'C': return PACKET_C_SIZE;
+        default: return 0;
+    }
+}
+
+void buildPacketIv(const uint8_t* encryptedPacket, char packetVersion, uint8_t iv[8]) {
+    uint32_t iv1;
+    memcpy(&iv1, &encryptedPacket[GT7_IV_OFFSET], sizeof(iv1));
+    uint32_t iv2;
+
+    switch (packetVersion)  {
+        case 'A': iv2 = iv1 ^ 0xDEADBEAF;
+            break;
+        case 'B': iv2 = iv1 ^ 0xDEADBEEF;
+            break;
+        case '~': iv2 = iv1 ^ 0x55FABB4F;
+            break;
+        case 'C': iv2 = iv1 ^ 0xDEADBEEF;
+            break;
+        default: iv2 = iv1;
+            break;
+    }
+
+    memcpy(&iv[0], &iv2, sizeof(iv2));
+    memcpy(&iv[4], &iv1, sizeof(iv1));
+}
@@ -0,0 +1,298 @@
+#include "GT7Serializer.h"
+#include <string.h>
+
+namespace {
+
+// Appends to a fixed buffer and remembers if anything did not fit
+class BufferWriter {
+    public:
+        BufferWriter(char* buffer, size_t capacity) : buffer(buffer), capacity(capacity), length(0), overflow(false) {}
+
+        void put(char c) {
+            if (length < capacity) {
+                buffer[length++] = c;
+            } else {
+                overflow = true;
+            }
+        }
+
+        void put(const char* text) {
+            while (*text != '\0') {
+                put(*text++);
+            }
+        }
+
+        void putUnsigned(uint64_t value) {
+            char digits[20];
+            uint8_t numDigits = 0;
+            do {
+                digits[numDigits++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (numDigits != 0) {
+                put(digits[--numDigits]);
+            }
+        }
+
+        void putSigned(int32_t value) {
+            if (value < 0) {
+                put('-');
+                putUnsigned(static_cast<uint64_t>(-static_cast<int64_t>(value)));
+            } else {
+                putUnsigned(static_cast<uint64_t>(value));
+            }
+        }
+
+        // Returns false for non-finite values and |value| >= 2^63, nothing is written in that case
+        bool putFloat(float value, uint8_t decimals) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF);
+            if (exponent >= 190) {
+                return false; // Infinity/NaN, or too large for the 64-bit integer part
+            }
+            if (decimals > 9) {
+                decimals = 9;
+            }
+
+            uint64_t scale = 1;
+            for (uint8_t i = 0; i < decimals; ++i) {
+                scale *= 10;
+            }
+
+            // |value| = mantissa * 2^shift. The fractional bits times 10^decimals fit in 54 bits, so the
+            // decimal digits are rounded from the exact product, half to even like printf.
+            uint64_t mantissa = exponent == 0 ? (bits & 0x7FFFFF) : ((bits & 0x7FFFFF) | 0x800000);
+            int32_t shift = (exponent == 0 ? 1 : exponent) - 150;
+            uint64_t integer = 0;
+            uint64_t scaled = 0;
+            if (shift >= 0) {
+                integer = mantissa << shift;
+            } else if (shift > -64) {
+                const uint8_t fractionBits = static_cast<uint8_t>(-shift);
+                const uint64_t fractionMask = (1ULL << fractionBits) - 1;
+                integer = mantissa >> fractionBits;
+                const uint64_t product = (mantissa & fractionMask) * scale;
+                const uint64_t remainder = product & fractionMask;
+                const uint64_t half = 1ULL << (fractionBits - 1);
+                scaled = product >> fractionBits;
+                const uint64_t lastDigit = decimals == 0 ? integer : scaled;
+                if (remainder > half || (remainder == half && (lastDigit & 1))) {
+                    ++scaled;
+                }
+            } // Below 2^-40 even 9 decimals round to 0
+
+            if (scaled >= scale) {
+                ++integer;
+                scaled -= scale;
+            }
+
+            if ((bits >> 31) && (integer != 0 || scaled != 0)) {
+                put('-');
+            }
+            putUnsigned(integer);
+            if (decimals != 0) {
+                put('.');
+                char digits[9];
+                for (uint8_t i = decimals; i != 0; --i) {
+                    digits[i - 1] = static_cast<char>('0' + scaled % 10);
+                    scaled /= 10;
+                }
+                for (uint8_t i = 0; i < decimals; ++i) {
+                    put(digits[i]);
+                }
+            }
+            return true;
+        }
+
+        size_t finish() {
+            if (overflow || length >= capacity) {
+                if (capacity != 0) {
+                    buffer[0] = '\0';
+                }
+                return 0;
+            }
+            buffer[length] = '\0';
+            return length;
+        }
+
+    private:
+        char* buffer;
+        size_t capacity;
+        size_t length;
+        bool overflow;
+};
+
+enum class TextFormat : uint8_t {
+    Json,
+    Csv
+};
+
+void putElement(BufferWriter& writer, const uint8_t* data, FieldType type, uint8_t decimals, TextFormat format) {
+    switch (type) {
+        case FieldType::UInt8:
+            writer.putUnsigned(*data);
+            break;
+        case FieldType::Int16: {
+            int16_t value;
+            memcpy(&value, data, sizeof(value));
+            writer.putSigned(value);
+            break;
+        }
+        case FieldType::Int32: {
+            int32_t value;
+            memcpy(&value, data, sizeof(value));
+            writer.putSigned(value);
+            break;
+        }
+        case FieldType::Float32: {
+            float value;
+            memcpy(&value, data, sizeof(value));
+            if (!writer.putFloat(value, decimals) && format == TextFormat::Json) {
+                writer.put("null"); // JSON has no NaN or infinity, CSV leaves the cell empty, same for out of range values
+            }
+            break;
+        }
+        case FieldType::Char:
+            break; // Written as a whole string by putField
+    }
+}
+
+void putField(BufferWriter& writer, const uint8_t* packet, const PacketField& field, uint8_t decimals, TextFormat format) {
+    const uint8_t* data = &packet[field.offset];
+
+    if (field.type == FieldType::Char) {
+        // Char arrays are short strings (surfaceType, carCategory), printable ASCII up to the first NUL
+        if (format == TextFormat::Json) {
+            writer.put('"');
+        }
+        for (uint8_t i = 0; i < field.count && data[i] != 0; ++i) {
+            char c = static_cast<char>(data[i]);
+            if (c >= ' ' && c <= '~' && c != '"' && c != '\\' && c != ',') {
+                writer.put(c);
+            }
+        }
+        if (format == TextFormat::Json) {
+            writer.put('"');
+        }
+        return;
+    }
+
+    const uint8_t elementSize = fieldTypeSize(field.type);
+    if (format == TextFormat::Json && field.count > 1) {
+        writer.put('[');
+    }
+    for (uint8_t i = 0; i < field.count; ++i) {
+        if (i != 0) {
+            writer.put(',');
+        }
+        putElement(writer, &data[i * elementSize], field.type, decimals, format);
+    }
+    if (format == TextFormat::Json && field.count > 1) {
+        writer.put(']');
+    }
+}
+
+}
+
+size_t formatFloat(char* buffer, size_t capacity, float value, uint8_t decimals) {
+    BufferWriter writer(buffer, capacity);
+    if (!writer.putFloat(value, decimals)) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        bool isNan = ((bits >> 23) & 0xFF) == 0xFF && (bits & 0x7FFFFF) != 0;
+        writer.put(isNan ? "nan" : ((bits >> 31) ? "-inf" : "inf")); // Finite values beyond 2^63 are written as infinity
+    }
+    return writer.finish();
+}
+
+size_t writePacketJson(char* buffer, size_t capacity, const PacketC& packet, char packetVersion, uint8_t decimals) {
+    BufferWriter writer(buffer, capacity);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&packet);
+    const size_t numFields = gt7NumFieldsForSize(getPacketSize(packetVersion));
+
+    writer.put('{');
+    for (size_t i = 0; i < numFields; ++i) {
+        if (i != 0) {
+            writer.put(',');
+        }
+        writer.put('"');
+        writer.put(GT7_PACKET_FIELDS[i].name);
+        writer.put("\":");
+        putField(writer, data, GT7_PACKET_FIELDS[i], decimals, TextFormat::Json);
+    }
+    writer.put('}');
+    return writer.finish();
+}
+
+size_t writePacketCsvHeader(char* buffer, size_t capacity, char packetVersion) {
+    BufferWriter writer(buffer, capacity);
+    const size_t numFields = gt7NumFieldsForSize(getPacketSize(packetVersion));
+
+    for (size_t i = 0; i < numFields; ++i) {
+        const PacketField& field = GT7_PACKET_FIELDS[i];
+        // Strings take one column, numeric arrays one column per element
+        const uint8_t numColumns = field.type == FieldType::Char ? 1 : field.count;
+        for (uint8_t element = 0; element < numColumns; ++element) {
+            if (i != 0 || element != 0) {
+                writer.put(',');
+            }
+            writer.put(field.name);
+            if (numColumns > 1) {
+                writer.put('_');
+                writer.putUnsigned(element);
+            }
+        }
+    }
+    writer.put('\n');
+    return writer.finish();
+}
+
+size_t writePacketCsvRow(char* buffer, size_t capacity, const PacketC& packet, char packetVersion, uint8_t decimals) {
+    BufferWriter writer(buffer, capacity);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&packet);
+    const size_t numFields = gt7NumFieldsForSize(getPacketSize(packetVersion));
+
+    for (size_t i = 0; i < numFields; ++i) {
+        if (i != 0) {
+            writer.put(',');
+        }
+        putField(writer, data, GT7_PACKET_FIELDS[i], decimals, TextFormat::Csv);
+    }
+    writer.put('\n');
+    return writer.finish();
+}
+
+size_t writePacketSchema(uint8_t* buffer, size_t capacity) {
+    size_t length = 0;
+    auto put = [&](uint8_t byte) {
+        if (length < capacity) {
+            buffer[length] = byte;
+        }
+        ++length;
+    };
+
+    put('G');
+    put('T');
+    put('7');
+    put('S');
+    put(GT7_SCHEMA_VERSION);
+    put(static_cast<uint8_t>(GT7_NUM_PACKET_FIELDS));
+    for (const PacketField& field : GT7_PACKET_FIELDS) {
+        put(static_cast<uint8_t>(field.offset));
+        put(static_cast<uint8_t>(field.offset >> 8));
+        put(static_cast<uint8_t>(field.type));
+        put(field.count);
+        const size_t nameLength = strlen(field.name);
+        put(static_cast<uint8_t>(nameLength));
+        for (size_t i = 0; i < nameLength; ++i) {
+            put(static_cast<uint8_t>(field.name[i]));
+        }
+        const size_t unitLength = strlen(field.unit);
+        put(static_cast<uint8_t>(unitLength));
+        for (size_t i = 0; i < unitLength; ++i) {
+            put(static_cast<uint8_t>(field.unit[i]));
+        }
+    }
+    return length <= capacity ? length : 0;
+}
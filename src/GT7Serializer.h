@@ -0,0 +1,56 @@
+#ifndef GT7SERIALIZER_H
+#define GT7SERIALIZER_H
+
+// Allocation-free text and binary serializers driven by GT7_PACKET_FIELDS. Floats are formatted
+// with integer arithmetic only, no printf. All writers return the number of bytes written
+// (text writers also append a terminating NUL that is not counted), or 0 if the buffer is too small.
+// Only fields contained in the given packet version are written.
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "GT7PacketFields.h"
+
+constexpr uint8_t GT7_SCHEMA_VERSION = 1;
+
+size_t formatFloat(char* buffer, size_t capacity, float value, uint8_t decimals); // Correctly rounded, "nan"/"inf" for non-finite values and |value| >= 2^63, decimals <= 9
+size_t writePacketJson(char* buffer, size_t capacity, const PacketC& packet, char packetVersion = 'C', uint8_t decimals = 3); // {"magic":...,"position":[...],...}
+size_t writePacketCsvHeader(char* buffer, size_t capacity, char packetVersion = 'C'); // Arrays become name_0,name_1,...
+size_t writePacketCsvRow(char* buffer, size_t capacity, const PacketC& packet, char packetVersion = 'C', uint8_t decimals = 3);
+
+// Binary schema: "GT7S", uint8 schema version, uint8 field count, then for every field:
+// uint16 offset (little-endian), uint8 FieldType, uint8 count, uint8 name length, name,
+// uint8 unit length, unit. Strings are not NUL terminated.
+size_t writePacketSchema(uint8_t* buffer, size_t capacity);
+
+// Longest text a single element can produce, floats print at most 19 integer digits (|value| < 2^63)
+constexpr size_t gt7ElementMaxLength(FieldType type, uint8_t decimals) {
+    return type == FieldType::UInt8 ? 3 : type == FieldType::Int16 ? 6 : type == FieldType::Int32 ? 11 :
+        type == FieldType::Float32 ? 20 + (decimals == 0 ? 0 : 1 + (decimals > 9 ? 9 : decimals)) : 1;
+}
+
+constexpr size_t gt7FieldValueMaxLength(const PacketField& field, uint8_t decimals) {
+    return field.type == FieldType::Char ? field.count : field.count * (gt7ElementMaxLength(field.type, decimals) + 1) - 1;
+}
+
+constexpr size_t gt7StringLength(const char* text) {
+    return *text == '\0' ? 0 : 1 + gt7StringLength(text + 1);
+}
+
+constexpr size_t gt7PacketSchemaSize(size_t index = 0) {
+    return index == GT7_NUM_PACKET_FIELDS ? 6 :
+        6 + gt7StringLength(GT7_PACKET_FIELDS[index].name) + gt7StringLength(GT7_PACKET_FIELDS[index].unit) + gt7PacketSchemaSize(index + 1);
+}
+
+// Worst-case buffer sizes for a Packet "C" including the terminating NUL, e.g. char json[gt7PacketJsonMaxSize(3)];
+constexpr size_t gt7PacketJsonMaxSize(uint8_t decimals, size_t index = 0) {
+    return index == GT7_NUM_PACKET_FIELDS ? 3 :
+        (index == 0 ? 0 : 1) + 3 + gt7StringLength(GT7_PACKET_FIELDS[index].name) + gt7FieldValueMaxLength(GT7_PACKET_FIELDS[index], decimals) +
+        (GT7_PACKET_FIELDS[index].type == FieldType::Char ? 2 : (GT7_PACKET_FIELDS[index].count > 1 ? 2 : 0)) + gt7PacketJsonMaxSize(decimals, index + 1);
+}
+
+constexpr size_t gt7PacketCsvRowMaxSize(uint8_t decimals, size_t index = 0) {
+    return index == GT7_NUM_PACKET_FIELDS ? 2 :
+        (index == 0 ? 0 : 1) + gt7FieldValueMaxLength(GT7_PACKET_FIELDS[index], decimals) + gt7PacketCsvRowMaxSize(decimals, index + 1);
+}
+
+#endif
@@ -1,31 +1,10 @@
 #include <WiFiUdp.h>
 #include "GT7UDPParser.h"
 #include "Salsa20.h"
-#include <string>
-#include <array>
 #include <vector>
 
 constexpr unsigned int localPort = 33740; 
 constexpr unsigned int remotePort = 33739; 
-constexpr int PACKET_A_SIZE = 296;
-constexpr int PACKET_B_SIZE = 316;
-constexpr int PACKET_TILDA_SIZE = 344;
-constexpr int PACKET_C_SIZE = 368;
-const std::string Key = "Simulator Interface Packet GT7 ver 0.0";
-
-
-union IntToBytes {
-    uint32_t integer;
-    uint8_t bytes[4];
-};
-
-std::array<uint8_t, 32> GT7_UDP_Parser::getAsciiBytes(const std::string& inputString) {
-    std::array<uint8_t, 32> asciiBytes = {};
-    for (size_t i = 0; i < inputString.size() && i < asciiBytes.size(); ++i) {
-        asciiBytes[i] = static_cast<uint8_t>(inputString[i]);
-    }
-    return asciiBytes;
-}
 
 void GT7_UDP_Parser::begin(const IPAddress playstationIP, const char packetVersion) {
     Udp.begin(localPort);
@@ -35,7 +14,7 @@ void GT7_UDP_Parser::begin(const IPAddress playstationIP, const char packetVersi
     } else {
     heartbeatMsg = 'A';
     }
-    dKey = getAsciiBytes(Key);
+    resetLatencyStats();
 }
 
 void GT7_UDP_Parser::sendHeartbeat(void) {
@@ -68,18 +47,50 @@ uint8_t GT7_UDP_Parser::getPowertrainType(void) {
     }
 }
 
+char GT7_UDP_Parser::getPacketVersion(void) {
+    return detectedPacketVersion;
+}
+
 float GT7_UDP_Parser::getTyreSpeed(int index) {
+#ifdef GT7_FIXED_POINT
+    return q16ToFloat(getTyreSpeedQ16(index));
+#else
     if (index >= 0 && index < 4) {
         return abs(3.6f * packet.packetContent.tyreRadius[index] * packet.packetContent.wheelRPS[index]);
     } else return 0.0f;
+#endif
 }
 
 float GT7_UDP_Parser::getTyreSlipRatio(int index) {
-    float carSpeed = (packet.packetContent.speed * 3.6);
+#ifdef GT7_FIXED_POINT
+    return q16ToFloat(getTyreSlipRatioQ16(index));
+#else
+    float carSpeed = (packet.packetContent.speed * 3.6f);
     float tyreSpeed = getTyreSpeed(index);
     if (carSpeed != 0.0f) {
         return tyreSpeed / carSpeed;
     } else return 0.0f;
+#endif
+}
+
+q16_t GT7_UDP_Parser::getTyreSpeedQ16(int index) {
+    return gt7TyreSpeedQ16(packet.packetContent, index);
+}
+
+q16_t GT7_UDP_Parser::getTyreSlipRatioQ16(int index) {
+    return gt7TyreSlipRatioQ16(packet.packetContent, index);
+}
+
+q16_t GT7_UDP_Parser::getSpeedKmhQ16(void) {
+    return gt7SpeedKmhQ16(packet.packetContent);
+}
+
+q16_t GT7_UDP_Parser::getBoostQ16(void) {
+    return gt7BoostQ16(packet.packetContent);
+}
+
+q16_t GT7_UDP_Parser::getTargetRPMQ16(int gear, q16_t finalDrive) {
+    return gt7TargetRPMQ16(packet.packetContent, gear, finalDrive);
 }
 
 uint8_t GT7_UDP_Parser::getFlag(int index) {
@@ -99,49 +110,126 @@ Packet GT7_UDP_Parser::readData() {
     uint8_t recvBuffer[sizeof(packet.packetContent)];
     memset(recvBuffer, 0, sizeof(recvBuffer));
     int packetSize = Udp.parsePacket();
+    if (packetSize > 0) {
+        uint32_t now = micros();
+        if (receiveMicros != 0) {
+            uint32_t interval = now - receiveMicros;
+            if (lastInterval != 0) {
+                latency[static_cast<uint8_t>(LatencyStage::InterArrivalJitter)].record(interval > lastInterval ? interval - lastInterval : lastInterval - interval);
+            }
+            lastInterval = interval;
+        }
+        receiveMicros = now;
+    }
     int byteStream = Udp.read(recvBuffer, sizeof(recvBuffer));
     
-    if (byteStream == PACKET_A_SIZE) {
-        detectedPacketVersion = 'A';
-    } else if (byteStream == PACKET_B_SIZE) {
-        detectedPacketVersion = 'B';
-    } else if (byteStream == PACKET_TILDA_SIZE) {
-        detectedPacketVersion = '~';
-    } else if (byteStream == PACKET_C_SIZE) {
-        detectedPacketVersion = 'C';
-    } else {
-        detectedPacketVersion = ' ';
-    }
+    detectedPacketVersion = detectPacketVersion(byteStream);
 
-    int iv1 = *reinterpret_cast<int*>(&recvBuffer[0x40]); // Seed IV is always located there
-    
-    switch (detectedPacketVersion)  {
-        case 'A': iv2 = iv1 ^ 0xDEADBEAF;
-            break;
-        case 'B': iv2 = iv1 ^ 0xDEADBEEF;
-            break;
-        case '~': iv2 = iv1 ^ 0x55FABB4F;
-            break;
-        case 'C': iv2 = iv1 ^ 0xDEADBEEF;
-            break;
-        default: iv2 = iv1;
-            break;
-    }
-
-    IntToBytes iv1Bytes, iv2Bytes;
-    iv1Bytes.integer = iv1;
-    iv2Bytes.integer = iv2;
-
-     uint8_t iv[8] = {
-        iv2Bytes.bytes[0], iv2Bytes.bytes[1], iv2Bytes.bytes[2], iv2Bytes.bytes[3],
-        iv1Bytes.bytes[0], iv1Bytes.bytes[1], iv1Bytes.bytes[2], iv1Bytes.bytes[3]
-    };
-
-    ucstk::Salsa20 salsa20(dKey.data());
+    uint8_t iv[8];
+    buildPacketIv(recvBuffer, detectedPacketVersion, iv);
+
+    ucstk::Salsa20 salsa20(GT7_KEY);
     salsa20.setIv(iv);
 
     std::vector<uint8_t> decryptedData(byteStream);
     salsa20.processBytes((recvBuffer), decryptedData.data(), byteStream);
     memcpy(&packet.packetContent, decryptedData.data(), byteStream);
+
+    if (packetSize > 0) {
+        decryptMicros = micros();
+        latency[static_cast<uint8_t>(LatencyStage::ReceiveToDecrypt)].record(decryptMicros - receiveMicros);
+        pendingConsume = true;
+    }
     return packet;
-    }
\ No newline at end of file
+    }
+
+uint32_t GT7_UDP_Parser::getReceiveMicros(void) {
+    return receiveMicros;
+}
+
+void GT7_UDP_Parser::markConsumed(void) {
+    if (!pendingConsume) {
+        return; // Only the first consumer of each packet is measured
+    }
+    pendingConsume = false;
+    latency[static_cast<uint8_t>(LatencyStage::DecryptToConsumer)].record(micros() - decryptMicros);
+}
+
+const LatencyHistogram& GT7_UDP_Parser::getLatencyHistogram(LatencyStage stage) {
+    return latency[static_cast<uint8_t>(stage)];
+}
+
+void GT7_UDP_Parser::resetLatencyStats(void) {
+    for (LatencyHistogram& histogram : latency) {
+        histogram.reset();
+    }
+    receiveMicros = 0;
+    decryptMicros = 0;
+    lastInterval = 0;
+    pendingConsume = false;
+}
+
+void GT7_UDP_Parser::printLatencyStats(Print& output) {
+    static const char* const stageNames[] = {"recv_to_decrypt", "decrypt_to_consumer", "jitter"};
+    for (uint8_t stage = 0; stage < 3; ++stage) {
+        const LatencyHistogram& histogram = latency[stage];
+        output.print(stageNames[stage]);
+        output.print(',');
+        output.print(histogram.samples);
+        output.print(',');
+        output.print(static_cast<uint32_t>(histogram.samples ? histogram.totalMicros / histogram.samples : 0));
+        output.print(',');
+        output.print(histogram.maxMicros);
+        output.print(',');
+        output.print(histogram.percentileMicros(50));
+        output.print(',');
+        output.print(histogram.percentileMicros(99));
+        for (uint8_t bucket = 0; bucket < LatencyHistogram::BUCKETS; ++bucket) {
+            output.print(',');
+            output.print(histogram.counts[bucket]);
+        }
+        output.println();
+    }
+}
+
+void LatencyHistogram::record(uint32_t sampleMicros) {
+    uint8_t bucket = 0;
+    while (sampleMicros >> bucket && bucket < BUCKETS - 1) { // Index of the highest set bit + 1, no division needed
+        ++bucket;
+    }
+    ++counts[bucket];
+    ++samples;
+    totalMicros += sampleMicros;
+    if (sampleMicros > maxMicros) {
+        maxMicros = sampleMicros;
+    }
+}
+
+void LatencyHistogram::reset() {
+    memset(counts, 0, sizeof(counts));
+    samples = 0;
+    maxMicros = 0;
+    totalMicros = 0;
+}
+
+uint32_t LatencyHistogram::bucketUpperMicros(uint8_t bucket) const {
+    if (bucket >= BUCKETS - 1) {
+        return maxMicros + 1;
+    }
+    return 1UL << bucket;
+}
+
+uint32_t LatencyHistogram::percentileMicros(uint8_t percent) const {
+    if (samples == 0) {
+        return 0;
+    }
+    uint64_t target = (static_cast<uint64_t>(samples) * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= target) {
+            return bucketUpperMicros(bucket);
+        }
+    }
+    return maxMicros;
+}
\ No newline at end of file
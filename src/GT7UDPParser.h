@@ -3,115 +3,25 @@
 
 #include <inttypes.h>
 #include <WiFiUdp.h>
-#include <array>
-#include <string>
+#include "GT7Packets.h"
+#include "GT7FixedPoint.h"
 
-#pragma pack(push, 1)
-
-enum class SimulatorFlags : int16_t {
-    None = 0,
-
-    CarOnTrack = 1 << 0,
-
-    Paused = 1 << 1,
-
-    LoadingOrProcessing = 1 << 2,
-
-    InGear = 1 << 3,
-
-    HasTurbo = 1 << 4,
-
-    RevLimiterBlinkAlertActive = 1 << 5,
-
-    HandBrakeActive = 1 << 6,
-
-    LightsActive = 1 << 7,
-
-    HighBeamActive = 1 << 8,
-
-    LowBeamActive = 1 << 9,
-
-    ASMActive = 1 << 10,
-
-    TCSActive = 1 << 11
-};
-
-struct PacketA { 
-    int32_t magic; // Magic, different value defines what game is being played 
-    float position[3]; // Position on Track in meters in each axis
-    float worldVelocity[3]; // Velocity in meters for each axis
-    float rotation[3]; // Rotation (Pitch/Yaw/Roll) (RANGE: -1 -> 1)
-    float orientationRelativeToNorth; // Orientation to North (RANGE: 1.0 (North) -> 0.0 (South))
-    float angularVelocity[3]; // Speed at which the car turns around axis in rad/s (RANGE: -1 -> 1)
-    float bodyHeight; // Body height
-    float EngineRPM; // Engine revolutions per minute
-    uint8_t iv[4]; // IV for Salsa20 encryption/decryption
-    float fuelLevel; // Fuel level of car in liters 
-    float fuelCapacity; // Max fuel capacity for current car (RANGE: 100 (most cars) -> 5 (karts) -> 0 (electric cars))  
-    float speed; // Speed in m/s
-    float boost; // Offset by +1 (EXAMPLE: 1.0 = 0 X 100kPa, 2.0 = 1 x 100kPa) // TODO apply -1 offset
-    float oilPressure; // Oil pressure in bars
-    float waterTemp; // Constantly 85
-    float oilTemp; // Constantly 110
-    float tyreTemp[4]; // Tyre temp for all 4 tires (FL -> FR -> RL -> RR)
-    int32_t packetId; // ID of packet
-    int16_t lapCount; // Lap count
-    int16_t totalLaps; // Laps to finish
-    int32_t bestLaptime; // Best lap time, defaults to -1 if not set
-    int32_t lastLaptime; // Previous lap time, defaults to -1 if not set
-    int32_t dayProgression; // Current time of day on track in ms
-    int16_t RaceStartPosition; // Position of the car before the start of the race, defaults to -1 after race start
-    int16_t preRaceNumCars; // Number of cars before the race start, defaults to -1 after start of the race
-    int16_t minAlertRPM; // Minimum RPM that the rev limiter displays an alert
-    int16_t maxAlertRPM; // Maximum RPM that the rev limiter displays an alert
-    int16_t calcMaxSpeed; // Highest possible speed achievable of the current transmission settings
-    SimulatorFlags flags; // Packet flags // TODO: Get working
-    uint8_t gears; // First 4 bits: Current Gear, Last 4 bits: Suggested Gear, see getCurrentGearFromByte and getSuggestedGearFromByte
-    uint8_t throttle; // Throttle (RANGE: 0 -> 255)
-    uint8_t brake; // Brake (RANGE: 0 -> 255)
-    uint8_t PADDING; // Padding byte
-    float roadPlane[3]; // Banking of the road 
-    float roadPlaneDistance; // Distance above or below the plane, e.g a dip in the road is negative, hill is positive.
-    float wheelRPS[4]; // Revolutions per second of tyres in rads
-    float tyreRadius[4]; // Radius of the tyre in meters
-    float suspHeight[4]; // Suspension height of the car
-    float UNKNOWNFLOATS[8]; // Unknown float
-    float clutch; // Clutch (RANGE: 0.0 -> 1.0)
-    float clutchEngagement; // Clutch Engangement (RANGE: 0.0 -> 1.0)
-    float RPMFromClutchToGearbox; // Pretty much same as engine RPM, is 0 when clutch is depressed
-    float transmissionTopSpeed; // Top speed as gear ratio value
-    float gearRatios[8]; // Gear ratios of the car up to 8
-    int32_t carCode; // This value may be overriden if using a car with more then 9 gears
-};
-
-struct PacketB : public PacketA {
-    float wheelRotation; // Calculates the wheel rotation in radians
-    float steeringAngularVelocity; // Angular velocity of the steering wheel in rad/s
-    float sway; // X axis acceleration
-    float heave; // Y axis acceleration
-    float surge; // Z axis acceleration
+enum class LatencyStage : uint8_t {
+    ReceiveToDecrypt = 0, // parsePacket() -> decrypted packet available
+    DecryptToConsumer = 1, // Decrypted packet -> markConsumed() called by the application
+    InterArrivalJitter = 2 // Difference between consecutive packet inter-arrival times
 };
 
-struct PacketTilda : public PacketB {
-    uint8_t throttleFiltered; // Filtered Throttle Output
-    uint8_t brakeFiltered; // Filtered Brake Output
-    uint8_t UNKNOWNUINT81; // Unknown unsigned 8 bit integer
-    uint8_t UNKNOWNUINT82; // Unknown unsigned 8 bit integer
-    float torqueVectors[4]; // Torque vectoring for certain cars - Positive = driving force - Negative = braking or regenerating
-    float energyRecovery; // Energy being recovered to the battery
-    float UNKNOWNFLOAT11; // Unknown float
-};
-
-struct PacketC : public PacketTilda {
-    char surfaceType[4]; // The kind of surface in contact with the tyres (T: tarmac, C: curb/kerb D: Dirt/Grass)
-    int32_t currentLap; // The current lap being set in milliseconds
-    float wheelSteeringAngle[2]; // Steering angle of the front wheels in radians (left to right)
-    float wheelBase; // Distance between the front and rear axles in meters (front left  of the car to rear left of the car)
-    char carCategory[4]; // Null terminated string of car category (GR3, GRX etc.)
-};
-
-struct Packet {
-    PacketC packetContent;
+struct LatencyHistogram {
+    static constexpr uint8_t BUCKETS = 20; // Bucket 0: 0us, bucket n: [2^(n-1), 2^n) us, last bucket also holds anything larger
+    uint32_t counts[BUCKETS]; // Number of samples per bucket
+    uint32_t samples; // Total number of samples recorded
+    uint32_t maxMicros; // Largest sample recorded in microseconds
+    uint64_t totalMicros; // Sum of all samples, used for the mean
+    void record(uint32_t sampleMicros);
+    void reset();
+    uint32_t bucketUpperMicros(uint8_t bucket) const; // Exclusive upper bound of a bucket in microseconds
+    uint32_t percentileMicros(uint8_t percent) const; // Upper bound of the bucket containing the given percentile
 };
 
 class GT7_UDP_Parser {
@@ -122,20 +32,31 @@ class GT7_UDP_Parser {
         uint8_t getCurrentGearFromByte(void);
         uint8_t getSuggestedGearFromByte(void);
         uint8_t getPowertrainType(void);
+        char getPacketVersion(void); // Version of the last packet: 'A', 'B', '~', 'C' or ' ' if unknown
         float getTyreSpeed(int index);
         float getTyreSlipRatio(int index);
+        q16_t getTyreSpeedQ16(int index); // Integer-only versions for FPU-less targets, see GT7FixedPoint.h
+        q16_t getTyreSlipRatioQ16(int index);
+        q16_t getSpeedKmhQ16(void);
+        q16_t getBoostQ16(void); // Boost with the +1 offset removed
+        q16_t getTargetRPMQ16(int gear, q16_t finalDrive = Q16_ONE);
         Packet readData();
+        uint32_t getReceiveMicros(void); // micros() timestamp of the last received datagram
+        void markConsumed(void); // Call once the application has acted on the last packet
+        const LatencyHistogram& getLatencyHistogram(LatencyStage stage);
+        void resetLatencyStats(void);
+        void printLatencyStats(Print& output); // CSV: stage,samples,mean,max,p50,p99,bucket counts...
     private: 
         WiFiUDP Udp;
         IPAddress remoteIP;
         Packet packet;
-        int iv2;
         char detectedPacketVersion;
         char heartbeatMsg;
-        std::array<uint8_t, 32> dKey;
-        std::array<uint8_t, 32> getAsciiBytes(const std::string& inputString);
+        uint32_t receiveMicros;
+        uint32_t decryptMicros;
+        uint32_t lastInterval;
+        bool pendingConsume;
+        LatencyHistogram latency[3];
 };
 
-#pragma pack(pop)
-
 #endif
\ No newline at end of file
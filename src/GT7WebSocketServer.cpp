@@ -0,0 +1,282 @@
+#include "GT7WebSocketServer.h"
+#include <string.h>
+#if defined(ESP32)
+#include <errno.h>
+#include <lwip/sockets.h>
+#endif
+
+constexpr uint8_t OPCODE_BINARY = 0x2;
+constexpr uint8_t OPCODE_CLOSE = 0x8;
+const char KEY_HEADER[] = "sec-websocket-key:";
+
+GT7_WebSocket_Server::GT7_WebSocket_Server(uint16_t port) : server(port), lastVersion(' '), hasLastBroadcast(false) {
+    for (Slot& slot : slots) {
+        slot.state = SlotState::Free;
+    }
+}
+
+void GT7_WebSocket_Server::begin() {
+    server.begin();
+}
+
+uint8_t GT7_WebSocket_Server::getNumClients() {
+    uint8_t numClients = 0;
+    for (Slot& slot : slots) {
+        if (slot.state == SlotState::Open) {
+            ++numClients;
+        }
+    }
+    return numClients;
+}
+
+void GT7_WebSocket_Server::poll() {
+    acceptClients();
+    for (Slot& slot : slots) {
+        if (slot.state == SlotState::Free) {
+            continue;
+        }
+        if (!slot.client.connected()) {
+            closeSlot(slot);
+        } else if (slot.state == SlotState::Handshake) {
+            readHandshake(slot);
+        } else {
+            readFrames(slot);
+        }
+    }
+}
+
+void GT7_WebSocket_Server::acceptClients() {
+    WiFiClient client = server.available();
+    if (!client) {
+        return;
+    }
+    for (Slot& slot : slots) {
+        if (slot.state == SlotState::Free) {
+            slot.client = client;
+            slot.client.setNoDelay(true); // Telemetry frames are small and latency sensitive
+            slot.state = SlotState::Handshake;
+            slot.connectedMillis = millis();
+            slot.lineLength = 0;
+            slot.keyLength = 0;
+            slot.frameHeaderLength = 0;
+            slot.payloadRemaining = 0;
+            slot.hasBaseline = false;
+            slot.inSync = false;
+            return;
+        }
+    }
+    client.stop(); // All slots are taken
+}
+
+void GT7_WebSocket_Server::readHandshake(Slot& slot) {
+    if (millis() - slot.connectedMillis > HANDSHAKE_TIMEOUT_MS) {
+        closeSlot(slot);
+        return;
+    }
+
+    while (slot.client.available() > 0) {
+        char c = static_cast<char>(slot.client.read());
+        if (c == '\r') {
+            continue;
+        }
+        if (c != '\n') {
+            if (slot.lineLength < sizeof(slot.line)) {
+                slot.line[slot.lineLength++] = c; // Longer lines are cut, only the key header matters
+            }
+            continue;
+        }
+
+        if (slot.lineLength == 0) {
+            // Empty line ends the request
+            char accept[GT7_WEBSOCKET_ACCEPT_SIZE];
+            if (!computeWebSocketAccept(slot.key, slot.keyLength, accept)) {
+                slot.client.print("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+                closeSlot(slot);
+                return;
+            }
+            slot.client.print("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: ");
+            slot.client.print(accept);
+            slot.client.print("\r\n\r\n");
+            slot.state = SlotState::Open;
+
+            uint8_t* payload = &message[GT7_WEBSOCKET_MAX_HEADER];
+            payload[0] = GT7_STREAM_SCHEMA;
+            size_t schemaLength = writePacketSchema(&payload[1], MESSAGE_SIZE - 1);
+            if (sendFrame(slot, message, 1 + schemaLength, OPCODE_BINARY) != SendResult::Sent) {
+                closeSlot(slot); // Every later message depends on the schema
+            }
+            return;
+        }
+
+        const size_t headerLength = sizeof(KEY_HEADER) - 1;
+        bool isKey = slot.lineLength > headerLength;
+        for (size_t i = 0; isKey && i < headerLength; ++i) {
+            char lower = (slot.line[i] >= 'A' && slot.line[i] <= 'Z') ? slot.line[i] - 'A' + 'a' : slot.line[i];
+            isKey = lower == KEY_HEADER[i];
+        }
+        if (isKey) {
+            slot.keyLength = 0;
+            for (size_t i = headerLength; i < slot.lineLength && slot.keyLength < sizeof(slot.key); ++i) {
+                if (slot.line[i] != ' ') {
+                    slot.key[slot.keyLength++] = slot.line[i];
+                }
+            }
+        }
+        slot.lineLength = 0;
+    }
+}
+
+void GT7_WebSocket_Server::readFrames(Slot& slot) {
+    // Browsers only send control frames to this server, their payloads are skipped
+    while (slot.client.available() > 0) {
+        if (slot.payloadRemaining > 0) {
+            slot.client.read();
+            --slot.payloadRemaining;
+            continue;
+        }
+
+        slot.frameHeader[slot.frameHeaderLength++] = static_cast<uint8_t>(slot.client.read());
+        if (slot.frameHeaderLength < 2) {
+            continue;
+        }
+        uint8_t lengthCode = slot.frameHeader[1] & 0x7F;
+        uint8_t extendedLength = lengthCode == 126 ? 2 : (lengthCode == 127 ? 8 : 0);
+        uint8_t maskLength = (slot.frameHeader[1] & 0x80) ? 4 : 0;
+        if (slot.frameHeaderLength < 2 + extendedLength + maskLength) {
+            continue;
+        }
+
+        if ((slot.frameHeader[0] & 0x0F) == OPCODE_CLOSE) {
+            sendFrame(slot, message, 0, OPCODE_CLOSE);
+            closeSlot(slot);
+            return;
+        }
+        uint32_t payloadLength = lengthCode;
+        if (extendedLength != 0) {
+            payloadLength = 0;
+            for (uint8_t i = 0; i < extendedLength; ++i) {
+                payloadLength = (payloadLength << 8) | slot.frameHeader[2 + i];
+            }
+        }
+        slot.payloadRemaining = payloadLength;
+        slot.frameHeaderLength = 0;
+    }
+}
+
+bool GT7_WebSocket_Server::canWrite(Slot& slot, size_t length) {
+#if defined(ESP8266)
+    return static_cast<size_t>(slot.client.availableForWrite()) >= length;
+#elif defined(ESP32)
+    // availableForWrite() is not implemented on ESP32, poll the socket instead. lwIP only reports it
+    // writable with more than TCP_SNDLOWAT (about 2.8kB by default) free, enough for any frame.
+    (void)length;
+    int fd = slot.client.fd();
+    if (fd < 0) {
+        return false;
+    }
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(fd, &writeSet);
+    struct timeval timeout = {0, 0};
+    return select(fd + 1, nullptr, &writeSet, nullptr, &timeout) > 0;
+#else
+    (void)slot;
+    (void)length;
+    return true; // No send buffer query, a short write drops the client instead
+#endif
+}
+
+GT7_WebSocket_Server::SendResult GT7_WebSocket_Server::sendFrame(Slot& slot, uint8_t* buffer, size_t payloadLength, uint8_t opcode) {
+    // The header is written right in front of the payload so the frame goes out in one write
+    uint8_t header[GT7_WEBSOCKET_MAX_HEADER];
+    size_t headerLength = writeWebSocketHeader(header, opcode, payloadLength);
+    uint8_t* frame = &buffer[GT7_WEBSOCKET_MAX_HEADER - headerLength];
+    memcpy(frame, header, headerLength);
+    size_t frameLength = headerLength + payloadLength;
+#if defined(ESP32)
+    // WiFiClient::write() retries until everything is sent, which would stall every other client
+    int fd = slot.client.fd();
+    if (fd < 0) {
+        return SendResult::Failed;
+    }
+    ssize_t written = send(fd, frame, frameLength, MSG_DONTWAIT);
+    if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return SendResult::WouldBlock;
+    }
+#else
+    size_t written = slot.client.write(frame, frameLength);
+    if (written == 0) {
+        return SendResult::WouldBlock; // A closed connection is noticed by poll()
+    }
+#endif
+    return written == static_cast<decltype(written)>(frameLength) ? SendResult::Sent : SendResult::Failed;
+}
+
+void GT7_WebSocket_Server::skipFrame(Slot& slot) {
+    // The next message to this client covers everything since the last one it got
+    if (slot.inSync) {
+        slot.baseline = lastBroadcast;
+        slot.baselineVersion = lastVersion;
+        slot.inSync = false;
+    }
+}
+
+void GT7_WebSocket_Server::closeSlot(Slot& slot) {
+    slot.client.stop();
+    slot.state = SlotState::Free;
+}
+
+void GT7_WebSocket_Server::broadcast(const PacketC& packet, char packetVersion) {
+    const bool canShare = hasLastBroadcast && lastVersion == packetVersion;
+    size_t sharedLength = 0;
+    bool sharedEncoded = false;
+
+    for (Slot& slot : slots) {
+        if (slot.state != SlotState::Open) {
+            continue;
+        }
+
+        uint8_t* buffer = message;
+        size_t length = 0;
+        if (slot.inSync && canShare) {
+            // Clients that received the previous broadcast all need the same delta, encode it once
+            if (!sharedEncoded) {
+                sharedLength = encodeTelemetryDelta(&sharedDelta[GT7_WEBSOCKET_MAX_HEADER], GT7_STREAM_MAX_MESSAGE, lastBroadcast, packet, packetVersion);
+                sharedEncoded = true;
+            }
+            if (sharedLength != 0) {
+                buffer = sharedDelta;
+                length = sharedLength;
+            }
+        } else if (slot.hasBaseline && !slot.inSync && slot.baselineVersion == packetVersion) {
+            length = encodeTelemetryDelta(&message[GT7_WEBSOCKET_MAX_HEADER], MESSAGE_SIZE, slot.baseline, packet, packetVersion);
+        }
+        if (length == 0) {
+            length = encodeTelemetryKeyframe(&message[GT7_WEBSOCKET_MAX_HEADER], MESSAGE_SIZE, packet, packetVersion);
+            buffer = message;
+            if (length == 0) {
+                continue; // Unknown packet version
+            }
+        }
+
+        if (!canWrite(slot, GT7_WEBSOCKET_MAX_HEADER + length)) {
+            skipFrame(slot); // Slow client
+            continue;
+        }
+        SendResult result = sendFrame(slot, buffer, length, OPCODE_BINARY);
+        if (result == SendResult::WouldBlock) {
+            skipFrame(slot);
+            continue;
+        }
+        if (result == SendResult::Failed) {
+            closeSlot(slot); // A partial frame cannot be recovered from
+            continue;
+        }
+        slot.hasBaseline = true;
+        slot.inSync = true;
+    }
+
+    lastBroadcast = packet;
+    lastVersion = packetVersion;
+    hasLastBroadcast = true;
+}
@@ -0,0 +1,75 @@
+#ifndef GT7WEBSOCKETSERVER_H
+#define GT7WEBSOCKETSERVER_H
+
+// Serves the delta telemetry stream described in GT7DeltaStream.h to browsers over WebSocket.
+
+#include <inttypes.h>
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#endif
+#include "GT7DeltaStream.h"
+#include "GT7Serializer.h"
+
+class GT7_WebSocket_Server {
+    public:
+        static constexpr uint8_t MAX_CLIENTS = 4;
+        static constexpr uint32_t HANDSHAKE_TIMEOUT_MS = 2000;
+
+        GT7_WebSocket_Server(uint16_t port = 8080);
+        void begin();
+        void poll(); // Accepts clients, completes handshakes and handles close frames, call every loop
+        void broadcast(const PacketC& packet, char packetVersion); // Call once per new packet
+        uint8_t getNumClients();
+
+    private:
+        enum class SlotState : uint8_t {
+            Free,
+            Handshake,
+            Open
+        };
+
+        enum class SendResult : uint8_t {
+            Sent,
+            WouldBlock, // Nothing was written, the send buffer is full
+            Failed // Partial write or connection error, the stream cannot be recovered
+        };
+
+        struct Slot {
+            WiFiClient client;
+            PacketC baseline; // Last packet sent to this client, only kept while it lags behind
+            char baselineVersion;
+            bool hasBaseline;
+            bool inSync; // Last packet sent was the last broadcast, the shared delta applies
+            SlotState state;
+            uint32_t connectedMillis;
+            char line[96]; // Current request line during the handshake
+            uint8_t lineLength;
+            char key[32]; // Sec-WebSocket-Key
+            uint8_t keyLength;
+            uint8_t frameHeader[14]; // Incoming frame header being parsed
+            uint8_t frameHeaderLength;
+            uint32_t payloadRemaining; // Incoming payload bytes still to skip
+        };
+
+        void acceptClients();
+        void readHandshake(Slot& slot);
+        void readFrames(Slot& slot);
+        bool canWrite(Slot& slot, size_t length);
+        SendResult sendFrame(Slot& slot, uint8_t* buffer, size_t payloadLength, uint8_t opcode); // Payload starts at buffer + GT7_WEBSOCKET_MAX_HEADER
+        void skipFrame(Slot& slot);
+        void closeSlot(Slot& slot);
+
+        static constexpr size_t MESSAGE_SIZE = (1 + gt7PacketSchemaSize() > GT7_STREAM_MAX_MESSAGE) ? 1 + gt7PacketSchemaSize() : GT7_STREAM_MAX_MESSAGE;
+
+        WiFiServer server;
+        Slot slots[MAX_CLIENTS];
+        PacketC lastBroadcast;
+        char lastVersion;
+        bool hasLastBroadcast;
+        uint8_t message[GT7_WEBSOCKET_MAX_HEADER + MESSAGE_SIZE];
+        uint8_t sharedDelta[GT7_WEBSOCKET_MAX_HEADER + GT7_STREAM_MAX_MESSAGE];
+};
+
+#endif
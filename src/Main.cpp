@@ -21,11 +21,23 @@ THE SOFTWARE.
 */
 
 #include "Salsa20.h"
+#include "GT7CaptureDecoder.h"
 
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
 #include <string>
+#include <vector>
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define SALSA20_HAS_MMAP 1
+#include <atomic>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace ucstk;
 
@@ -35,7 +47,8 @@ using namespace ucstk;
 class Program
 {
 public:
-        Program(): inputFileName_(), outputFileName_(), shouldShowHelp_(false)
+        Program(): inputFileName_(), outputFileName_(), shouldShowHelp_(false), shouldUseMapping_(false),
+                   shouldDecodeCapture_(false)
         {
                 std::memset(key_, 0, sizeof(key_));
         }
@@ -55,22 +68,37 @@ public:
         {
                 std::string key;
                 shouldShowHelp_ = false;
+                shouldUseMapping_ = false;
+                shouldDecodeCapture_ = false;
 
                 for(int i = 0; i < argc; ++i)
                 {
                         std::string parameter = argv[i];
 
-                        if(parameter == "-p")
+                        if(parameter == "-p" || parameter == "-m")
                         {
                                 if((argc - i - 1) != 3)
                                         break;
 
+                                shouldUseMapping_ = (parameter == "-m");
+
                                 inputFileName_ = argv[++i];
                                 outputFileName_ = argv[++i];
                                 key = argv[++i];
                                 break;
                         }
 
+                        if(parameter == "-c")
+                        {
+                                if((argc - i - 1) != 2)
+                                        break;
+
+                                inputFileName_ = argv[++i];
+                                outputFileName_ = argv[++i];
+                                shouldDecodeCapture_ = true;
+                                break;
+                        }
+
                         if(parameter == "-h")
                         {
                                 shouldShowHelp_ = true;
@@ -90,7 +118,11 @@ public:
                         return false;
                 }
 
-                if(inputFileName_ == outputFileName_)
+                // capture files are decrypted with the fixed GT7 key and per-packet IVs
+                if(shouldDecodeCapture_)
+                        return true;
+
+                if(inputFileName_ == outputFileName_ && !shouldUseMapping_)
                 {
                         std::cout << "E: Input and output files should be distinct." << std::endl;
                         return false;
@@ -120,6 +152,8 @@ public:
                 if(shouldShowHelp_)
                 {
                         std::cout << "Usage: salsa20 -p INPUT OUTPUT KEY" << std::endl;
+                        std::cout << "       salsa20 -m INPUT OUTPUT KEY" << std::endl;
+                        std::cout << "       salsa20 -c CAPTURE PREFIX" << std::endl;
                         std::cout << "       salsa20 -h" << std::endl;
                         std::cout << std::endl << "Salsa20 is a stream cypher (see http://cr.yp.to/snuffle.html).";
                         std::cout << std::endl << std::endl;
@@ -129,9 +163,23 @@ public:
                         std::cout << std::endl;
                         std::cout << "     KEY is a 32-byte key concatenated with 8-byte IV written in HEX.";
                         std::cout << std::endl;
+                        std::cout << "  -m Same as -p, but memory-maps both files and processes chunks on all cores.";
+                        std::cout << std::endl;
+                        std::cout << "     INPUT and OUTPUT may be the same file, in which case it is processed in place.";
+                        std::cout << std::endl;
+                        std::cout << "  -c Decodes a capture of raw GT7 datagrams on all cores and writes one column";
+                        std::cout << std::endl;
+                        std::cout << "     file per packet field named PREFIX.FIELD.bin, described by PREFIX.schema.csv.";
+                        std::cout << std::endl;
                         return true;
                 }
 
+                if(shouldUseMapping_)
+                        return executeMapped();
+
+                if(shouldDecodeCapture_)
+                        return executeCaptureDecoding();
+
                 std::ifstream inputStream(inputFileName_, std::ios_base::binary);
                 if(!inputStream)
                 {
@@ -163,14 +211,20 @@ public:
                 salsa20.setIv(&key_[IV_OFFSET]);
                 std::cout << "Processing file \"" << inputFileName_ << '"' << std::endl;
 
+                int lastPercentage = -1;
                 for(decltype(numChunks) i = 0; i < numChunks; ++i)
                 {
                         inputStream.read(reinterpret_cast<char*>(chunk), sizeof(chunk));
                         salsa20.processBlocks(chunk, chunk, NUM_OF_BLOCKS_PER_CHUNK);
                         outputStream.write(reinterpret_cast<const char*>(chunk), sizeof(chunk));
 
-                        float percentage = 100.0f * static_cast<float>(i + 1) / static_cast<float>(numChunks);
-                        std::printf("[%3.2f]\r", percentage);
+                        // only report progress when the whole percentage changes
+                        int percentage = static_cast<int>(100 * (i + 1) / numChunks);
+                        if(percentage != lastPercentage)
+                        {
+                                lastPercentage = percentage;
+                                std::printf("[%3d.00]\r", percentage);
+                        }
                 }
 
                 if(remainderSize != 0)
@@ -186,6 +240,170 @@ public:
         }
 
 private:
+        /**
+         * \brief Encrypts or decrypts the file using memory mappings and all available cores.
+         *
+         * Since the key stream is seekable by block counter, every chunk is processed
+         * independently: worker threads take chunk indices from a shared counter, seek the
+         * cypher to the first block of the chunk and write the result straight into the
+         * output mapping.
+         * \return true on success
+         */
+        bool executeMapped()
+        {
+#ifdef SALSA20_HAS_MMAP
+                const bool inPlace = inputFileName_ == outputFileName_;
+
+                int inputFd = ::open(inputFileName_.c_str(), inPlace ? O_RDWR : O_RDONLY);
+                if(inputFd < 0)
+                {
+                        std::cout << "E: Could not open input file." << std::endl;
+                        return false;
+                }
+
+                struct stat inputStat;
+                if(::fstat(inputFd, &inputStat) != 0)
+                {
+                        std::cout << "E: Could not determine size of input file." << std::endl;
+                        ::close(inputFd);
+                        return false;
+                }
+                const size_t fileSize = static_cast<size_t>(inputStat.st_size);
+
+                int outputFd = inputFd;
+                if(!inPlace)
+                {
+                        outputFd = ::open(outputFileName_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                        if(outputFd < 0 || ::ftruncate(outputFd, static_cast<off_t>(fileSize)) != 0)
+                        {
+                                std::cout << "E: Could not create output file." << std::endl;
+                                if(outputFd >= 0)
+                                        ::close(outputFd);
+                                ::close(inputFd);
+                                return false;
+                        }
+                }
+
+                std::cout << "Processing file \"" << inputFileName_ << '"' << std::endl;
+
+                bool result = true;
+                if(fileSize != 0)
+                {
+                        void* output = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, outputFd, 0);
+                        void* input = inPlace ? output :
+                                ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, inputFd, 0);
+
+                        if(input == MAP_FAILED || output == MAP_FAILED)
+                        {
+                                std::cout << "E: Could not map files into memory." << std::endl;
+                                result = false;
+                        }
+                        else
+                        {
+                                ::madvise(input, fileSize, MADV_SEQUENTIAL);
+                                processMapped(static_cast<const uint8_t*>(input), static_cast<uint8_t*>(output), fileSize);
+                        }
+
+                        if(output != MAP_FAILED)
+                                ::munmap(output, fileSize);
+                        if(!inPlace && input != MAP_FAILED)
+                                ::munmap(input, fileSize);
+                }
+
+                if(!inPlace)
+                        ::close(outputFd);
+                ::close(inputFd);
+
+                if(!result)
+                        return false;
+
+                std::cout << "[100.00]" << std::endl << "OK" << std::endl;
+                return true;
+#else
+                std::cout << "E: Memory-mapped mode is not supported on this platform." << std::endl;
+                return false;
+#endif
+        }
+
+        /**
+         * \brief Decodes a capture file of GT7 datagrams into per-field columns.
+         * \return true on success
+         */
+        bool executeCaptureDecoding()
+        {
+#ifdef SALSA20_HAS_MMAP
+                GT7_Capture_Decoder decoder;
+                if(!decoder.open(inputFileName_))
+                {
+                        std::cout << "E: " << decoder.getError() << std::endl;
+                        return false;
+                }
+
+                std::cout << "Decoding " << decoder.getNumPackets() << " packets from \"" << inputFileName_ << '"' << std::endl;
+                if(!decoder.writeColumns(outputFileName_))
+                {
+                        std::cout << "E: " << decoder.getError() << std::endl;
+                        return false;
+                }
+
+                std::cout << "OK" << std::endl;
+                return true;
+#else
+                std::cout << "E: Capture decoding is not supported on this platform." << std::endl;
+                return false;
+#endif
+        }
+
+#ifdef SALSA20_HAS_MMAP
+        /**
+         * \brief Processes mapped data on a pool of worker threads.
+         * \param[in] input input
+         * \param[out] output output, may be equal to input
+         * \param[in] size number of bytes
+         */
+        void processMapped(const uint8_t* input, uint8_t* output, size_t size)
+        {
+                const size_t chunkSize = NUM_OF_BLOCKS_PER_CHUNK * Salsa20::BLOCK_SIZE;
+                const size_t numChunks = (size + chunkSize - 1) / chunkSize;
+
+                size_t numThreads = std::thread::hardware_concurrency();
+                if(numThreads == 0)
+                        numThreads = 1;
+                if(numThreads > numChunks)
+                        numThreads = numChunks;
+
+                std::atomic<size_t> nextChunk(0);
+                auto worker = [&]()
+                {
+                        Salsa20 salsa20(key_);
+                        salsa20.setIv(&key_[IV_OFFSET]);
+
+                        for(size_t i = nextChunk++; i < numChunks; i = nextChunk++)
+                        {
+                                const size_t offset = i * chunkSize;
+                                const size_t length = (size - offset) < chunkSize ? (size - offset) : chunkSize;
+
+                                salsa20.setCounter(static_cast<uint64_t>(i) * NUM_OF_BLOCKS_PER_CHUNK);
+                                salsa20.processBlocks(&input[offset], &output[offset], length / Salsa20::BLOCK_SIZE);
+
+                                const size_t remainder = length % Salsa20::BLOCK_SIZE;
+                                if(remainder != 0)
+                                        salsa20.processBytes(&input[offset + length - remainder],
+                                                             &output[offset + length - remainder], remainder);
+                        }
+                };
+
+                std::vector<std::thread> threads;
+                for(size_t i = 1; i < numThreads; ++i)
+                        threads.emplace_back(worker);
+
+                worker();
+
+                for(auto& thread: threads)
+                        thread.join();
+        }
+#endif
+
         /// Helper constants
         enum: size_t
         {
@@ -249,6 +467,8 @@ private:
         std::string inputFileName_, outputFileName_;
         uint8_t key_[KEY_SIZE];
         bool shouldShowHelp_;
+        bool shouldUseMapping_;
+        bool shouldDecodeCapture_;
 
 };
 
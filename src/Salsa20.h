@@ -35,6 +35,7 @@ namespace ucstk
         using std::int32_t;
         using std::uint8_t;
         using std::uint32_t;
+        using std::uint64_t;
 
         /**
          * Represents Salsa20 cypher. Supports only 256-bit keys.
@@ -74,6 +75,15 @@ namespace ucstk
                  */
                 inline void setIv(const uint8_t* iv);
 
+                /**
+                 * \brief Sets block counter.
+                 *
+                 * Allows random access into the key stream: the next generated block will be
+                 * the block with given index, counted from the start of the stream.
+                 * \param[in] blockIndex index of the next block
+                 */
+                inline void setCounter(uint64_t blockIndex);
+
                 /**
                  * \brief Generates key stream.
                  * \param[out] output generated key stream
@@ -67,6 +67,13 @@ namespace ucstk
                 vector_[8] = vector_[9] = 0;
         }
 
+        //----------------------------------------------------------------------------------
+        void Salsa20::setCounter(uint64_t blockIndex)
+        {
+                vector_[8] = static_cast<uint32_t>(blockIndex);
+                vector_[9] = static_cast<uint32_t>(blockIndex >> 32);
+        }
+
         //----------------------------------------------------------------------------------
         void Salsa20::generateKeyStream(uint8_t output[BLOCK_SIZE])
         {